@@ -0,0 +1,583 @@
+// ds2025_bench.cpp - Google Benchmark suite over the hot paths of every experiment
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+
+#include "apsp.h"
+#include "calculator.h"
+#include "complex.h"
+#include "components.h"
+#include "csr_graph.h"
+#include "datagen.h"
+#include "distributed.h"
+#include "fast_nms.h"
+#include "graph.h"
+#include "histogram.h"
+#include "huffman_tree.h"
+#include "nms.h"
+#include "partition.h"
+#include "traversal.h"
+
+using namespace ds2025;
+
+namespace {
+
+// The graph and BCC routines report through std::cout; send that to a sink while timing
+class MuteCout {
+public:
+    MuteCout() : old(std::cout.rdbuf(sink.rdbuf())) {}
+    ~MuteCout() { std::cout.rdbuf(old); }
+private:
+    std::ostringstream sink;
+    std::streambuf* old;
+};
+
+std::vector<int> heights(size_t n, int lo, int hi) {
+    std::vector<int> h(n);
+    datagen::fillHeights(h.data(), n, lo, hi, 2025);
+    return h;
+}
+
+}  // namespace
+
+// ========================= exp1 part 1: Complex =========================
+static void BM_ComplexIntroSort(benchmark::State& st) {
+    auto base = exp1::generateRandomComplexVector((int)st.range(0));
+    for (auto _ : st) {
+        st.PauseTiming(); auto v = base; st.ResumeTiming();
+        exp1::introSort(v, exp1::cmpByModulus);
+        benchmark::DoNotOptimize(v.data());
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK(BM_ComplexIntroSort)->Arg(1 << 14)->Arg(1 << 20);
+
+static void BM_ComplexMergeSort(benchmark::State& st) {
+    auto base = exp1::generateRandomComplexVector((int)st.range(0));
+    for (auto _ : st) {
+        st.PauseTiming(); auto v = base; st.ResumeTiming();
+        exp1::mergeSort(v, exp1::cmpByModulus);
+        benchmark::DoNotOptimize(v.data());
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK(BM_ComplexMergeSort)->Arg(1 << 14)->Arg(1 << 20);
+
+static void BM_ComplexSortByKey(benchmark::State& st) {
+    auto base = exp1::generateRandomComplexVector((int)st.range(0));
+    for (auto _ : st) {
+        st.PauseTiming(); auto v = base; st.ResumeTiming();
+        exp1::sortByKey(v, exp1::modulusKey);
+        benchmark::DoNotOptimize(v.data());
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK(BM_ComplexSortByKey)->Arg(1 << 14)->Arg(1 << 20);
+
+static void BM_ComplexBubbleSort(benchmark::State& st) {
+    auto base = exp1::generateRandomComplexVector((int)st.range(0));
+    for (auto _ : st) {
+        st.PauseTiming(); auto v = base; st.ResumeTiming();
+        exp1::bubbleSort(v, exp1::cmpByModulus);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_ComplexBubbleSort)->Arg(1 << 10);
+
+static void BM_ComplexIndexRangeQuery(benchmark::State& st) {
+    exp1::ComplexIndex idx(exp1::generateRandomComplexVector(1 << 20));
+    double r = 0;
+    for (auto _ : st) {
+        r = r < 13 ? r + 0.37 : 0;
+        benchmark::DoNotOptimize(idx.rangeQuery(r, r + 0.5));
+    }
+}
+BENCHMARK(BM_ComplexIndexRangeQuery);
+
+static void BM_ComplexKdTreeBuild(benchmark::State& st) {
+    auto v = exp1::generateRandomComplexVector(1 << 20);
+    for (auto _ : st) {
+        exp1::ComplexKdTree tree(v);
+        benchmark::DoNotOptimize(tree.size());
+    }
+}
+BENCHMARK(BM_ComplexKdTreeBuild)->Unit(benchmark::kMillisecond);
+
+static void BM_ComplexKdTreeNearest(benchmark::State& st) {
+    exp1::ComplexKdTree tree(exp1::generateRandomComplexVector(1 << 20));
+    datagen::CounterRng rng(7);
+    uint64_t i = 0;
+    for (auto _ : st) {
+        exp1::Complex q(rng.uniform(i, 0, 0, 10), rng.uniform(i, 1, 0, 10));
+        ++i;
+        benchmark::DoNotOptimize(tree.nearest(q, (size_t)st.range(0)));
+    }
+}
+BENCHMARK(BM_ComplexKdTreeNearest)->Arg(1)->Arg(16);
+
+static void BM_ComplexParallelDedup(benchmark::State& st) {
+    auto v = exp1::generateRandomComplexVector(1 << 20);
+    for (auto _ : st) benchmark::DoNotOptimize(exp1::parallelDedup(v, datagen::defaultThreads()));
+    st.SetItemsProcessed(st.iterations() * (int64_t)v.size());
+}
+BENCHMARK(BM_ComplexParallelDedup)->Unit(benchmark::kMillisecond);
+
+// ========================= exp1 part 2: calculator =========================
+static void BM_CalcEvaluate(benchmark::State& st) {
+    const std::string expr = "3.5 + 2.25 * (1.2 + 0.8) - -(2 + 3) ^ 2 / 7";
+    for (auto _ : st) benchmark::DoNotOptimize(exp1::evaluate(expr));
+}
+BENCHMARK(BM_CalcEvaluate);
+
+static void BM_CalcEvaluateColumns(benchmark::State& st, const char* expr) {
+    const size_t n = st.range(0);
+    exp1::CompiledExpr e = exp1::compile(expr);
+    std::vector<std::vector<double>> cols(e.vars.size(), std::vector<double>(n));
+    datagen::CounterRng rng(2025);
+    for (size_t v = 0; v < cols.size(); ++v)
+        for (size_t i = 0; i < n; ++i) cols[v][i] = rng.uniform(i, v, 0.5, 10);
+    std::vector<const double*> ptrs;
+    for (auto& c : cols) ptrs.push_back(c.data());
+    std::vector<double> out(n);
+    for (auto _ : st) {
+        exp1::evaluateColumns(e, ptrs, n, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(st.iterations() * (int64_t)n);
+}
+BENCHMARK_CAPTURE(BM_CalcEvaluateColumns, arith, "x*2 + y^2 - -z")->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_CalcEvaluateColumns, pow, "x ^ (y / 10) * z")->Arg(1 << 20);
+
+static void BM_CalcEvaluateBatch(benchmark::State& st) {
+    std::vector<std::string> exprs;
+    for (int i = 0; i < 1 << 14; ++i)
+        exprs.push_back(std::to_string(i % 97) + " * (" + std::to_string(i % 13) + " + 2.5) ^ 2 - " + std::to_string(i % 31));
+    exp1::ThreadPool pool;
+    exp1::ParseCache cache;
+    for (auto _ : st) benchmark::DoNotOptimize(exp1::evaluateBatch(exprs, pool, cache));
+    st.SetItemsProcessed(st.iterations() * (int64_t)exprs.size());
+}
+BENCHMARK(BM_CalcEvaluateBatch)->Unit(benchmark::kMillisecond);
+
+// ========================= exp1 part 3: histogram =========================
+static void BM_HistogramSerial(benchmark::State& st) {
+    auto h = heights(st.range(0), 0, 1000000);
+    for (auto _ : st) benchmark::DoNotOptimize(exp1::largestRectangleArea(h));
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK(BM_HistogramSerial)->Arg(1 << 20)->Arg(1 << 24);
+
+static void BM_HistogramParallel(benchmark::State& st) {
+    auto h = heights(st.range(0), 0, 1000000);
+    for (auto _ : st) benchmark::DoNotOptimize(exp1::largestRectangleAreaParallel(h.data(), h.size()));
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK(BM_HistogramParallel)->Arg(1 << 20)->Arg(1 << 24);
+
+static void BM_HistogramStreaming(benchmark::State& st) {
+    auto h = heights(st.range(0), 0, 1000000);
+    for (auto _ : st) {
+        exp1::StreamingHistogram s;
+        for (int x : h) s.push(x);
+        benchmark::DoNotOptimize(s.best());
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK(BM_HistogramStreaming)->Arg(1 << 20);
+
+static void BM_MaximalRectangle(benchmark::State& st) {
+    const int n = (int)st.range(0);
+    exp1::BitMatrix m(n, n);
+    datagen::CounterRng rng(2025);
+    for (int r = 0; r < n; ++r)
+        for (int c = 0; c < n; ++c)
+            if (rng.below((uint64_t)r * n + c, 0, 10) < 9) m.set(r, c);
+    for (auto _ : st) benchmark::DoNotOptimize(exp1::maximalRectangle(m));
+}
+BENCHMARK(BM_MaximalRectangle)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// ========================= exp2: Huffman =========================
+static void BM_HuffmanBuild(benchmark::State& st) {
+    std::unordered_map<char, int> freq;
+    datagen::CounterRng rng(2025);
+    for (int c = 0; c < 128; ++c) freq[(char)c] = 1 + (int)rng.below(c, 0, 1000);
+    for (auto _ : st) {
+        exp2::HuffNode* root = exp2::buildHuffmanTree(freq);
+        std::unordered_map<char, std::string> code;
+        exp2::generateCodes(root, "", code);
+        benchmark::DoNotOptimize(code.size());
+        exp2::freeHuffmanTree(root);
+    }
+}
+BENCHMARK(BM_HuffmanBuild);
+
+// ========================= exp3: graphs =========================
+namespace {
+
+// n nodes named by char codes 1..n, ring plus random chords, weights 1~100
+exp3::Graph randomGraph(int n, int chordsPerNode) {
+    std::vector<char> names(n);
+    for (int i = 0; i < n; ++i) names[i] = (char)(i + 1);
+    exp3::Graph g(n, names);
+    datagen::CounterRng rng(2025);
+    for (int i = 0; i < n; ++i) {
+        g.addEdge(i, (i + 1) % n, 1 + (int)rng.below(i, 0, 100));
+        for (int k = 0; k < chordsPerNode; ++k) {
+            int j = (int)rng.below(i, 1 + 2 * k, n);
+            if (j != i) g.addEdge(i, j, 1 + (int)rng.below(i, 2 + 2 * k, 100));
+        }
+    }
+    return g;
+}
+
+}  // namespace
+
+static void BM_GraphBFS(benchmark::State& st) {
+    exp3::Graph g = randomGraph(120, 4);
+    MuteCout mute;
+    for (auto _ : st) exp3::BFS(g, g.nodes[0]);
+}
+BENCHMARK(BM_GraphBFS);
+
+static void BM_GraphDFS(benchmark::State& st) {
+    exp3::Graph g = randomGraph(120, 4);
+    MuteCout mute;
+    for (auto _ : st) exp3::DFS(g, g.nodes[0]);
+}
+BENCHMARK(BM_GraphDFS);
+
+static void BM_GraphDijkstra(benchmark::State& st) {
+    exp3::Graph g = randomGraph(120, 4);
+    MuteCout mute;
+    for (auto _ : st) exp3::Dijkstra(g, g.nodes[0]);
+}
+BENCHMARK(BM_GraphDijkstra);
+
+static void BM_GraphPrim(benchmark::State& st) {
+    exp3::Graph g = randomGraph(120, 4);
+    MuteCout mute;
+    for (auto _ : st) exp3::Prim(g, g.nodes[0]);
+}
+BENCHMARK(BM_GraphPrim);
+
+static void BM_GraphBCC(benchmark::State& st) {
+    exp3::Graph g = randomGraph(120, 1);
+    std::vector<std::vector<int>> adj(g.n);
+    for (int i = 0; i < g.n; ++i)
+        for (int j = 0; j < g.n; ++j)
+            if (i != j && g.adjMatrix[i][j] != -1) adj[i].push_back(j);
+    MuteCout mute;
+    for (auto _ : st) {
+        exp3::BiconnectedComponent bcc(adj, g.nodes);
+        bcc.findBCCAndArticulation();
+    }
+}
+BENCHMARK(BM_GraphBCC);
+
+// R-MAT scale 16 (avg degree 16, undirected) cut into 4 shards, written once per run
+namespace {
+
+struct RmatShards {
+    exp3::CsrGraph g;
+    std::string dir;
+    std::vector<std::string> paths;
+
+    RmatShards() {
+        datagen::RmatParams p;
+        p.scale = 16;
+        size_t m = (size_t)16 << p.scale;
+        std::vector<uint32_t> src(m), dst(m);
+        std::vector<int> w(m);
+        datagen::fillRmatEdges(src.data(), dst.data(), w.data(), m, p, 2025);
+        g = exp3::csrFromEdges(1 << p.scale, src.data(), dst.data(), w.data(), m, true);
+        dir = (std::filesystem::temp_directory_path() / ("ds2025_bench_" + std::to_string(getpid()))).string();
+        paths = exp3::writeShards(g, 4, dir);
+    }
+    ~RmatShards() { std::filesystem::remove_all(dir); }
+
+    static RmatShards& get() {
+        static RmatShards s;
+        return s;
+    }
+};
+
+}  // namespace
+
+static void BM_CsrBFS(benchmark::State& st) {
+    auto& s = RmatShards::get();
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::bfsLevels(s.g, 0));
+    st.SetItemsProcessed(st.iterations() * s.g.edgeCount());
+}
+BENCHMARK(BM_CsrBFS)->Unit(benchmark::kMillisecond);
+
+static void BM_CsrDijkstra(benchmark::State& st) {
+    auto& s = RmatShards::get();
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::dijkstraDistances(s.g, 0));
+    st.SetItemsProcessed(st.iterations() * s.g.edgeCount());
+}
+BENCHMARK(BM_CsrDijkstra)->Unit(benchmark::kMillisecond);
+
+// arg 0: 0 = Unix sockets, 1 = shared memory
+static void BM_DistributedBFS(benchmark::State& st) {
+    auto& s = RmatShards::get();
+    exp3::TransportKind kind = st.range(0) ? exp3::TransportKind::SharedMemory : exp3::TransportKind::UnixSocket;
+    exp3::DistributedResult r;
+    for (auto _ : st) r = exp3::distributedBFS(s.paths, 0, kind);
+    st.counters["bytes"] = (double)r.bytesSent;
+    st.counters["rounds"] = (double)r.rounds;
+}
+BENCHMARK(BM_DistributedBFS)->ArgName("shm")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_DistributedSSSP(benchmark::State& st) {
+    auto& s = RmatShards::get();
+    exp3::TransportKind kind = st.range(0) ? exp3::TransportKind::SharedMemory : exp3::TransportKind::UnixSocket;
+    exp3::DistributedResult r;
+    for (auto _ : st) r = exp3::distributedSSSP(s.paths, 0, 25, kind);
+    st.counters["bytes"] = (double)r.bytesSent;
+    st.counters["rounds"] = (double)r.rounds;
+}
+BENCHMARK(BM_DistributedSSSP)->ArgName("shm")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Components on R-MAT graphs with (edgeFactor << scale) input edges; the undirected graph
+// stores both directions. Only the most recent graph is kept, to bound memory.
+namespace {
+
+const exp3::CsrGraph& rmatGraph(int scale, int edgeFactor, bool symmetric) {
+    static exp3::CsrGraph g;
+    static int key[3] = {-1, -1, -1};
+    if (key[0] != scale || key[1] != edgeFactor || key[2] != (int)symmetric) {
+        g = exp3::CsrGraph();
+        datagen::RmatParams p;
+        p.scale = scale;
+        size_t m = (size_t)edgeFactor << scale;
+        std::vector<uint32_t> src(m), dst(m);
+        std::vector<int> w(m);
+        datagen::fillRmatEdges(src.data(), dst.data(), w.data(), m, p, 2025);
+        g = exp3::csrFromEdges(1 << scale, src.data(), dst.data(), w.data(), m, symmetric);
+        key[0] = scale; key[1] = edgeFactor; key[2] = symmetric;
+    }
+    return g;
+}
+
+// args: scale, edge factor
+void BM_ConnectedComponents(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), true);
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::connectedComponents(g));
+    st.SetItemsProcessed(st.iterations() * g.edgeCount());
+}
+
+void BM_ConnectedComponentsBFS(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), true);
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::connectedComponentsBFS(g));
+    st.SetItemsProcessed(st.iterations() * g.edgeCount());
+}
+
+void BM_TarjanSCC(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), false);
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::tarjanSCC(g));
+    st.SetItemsProcessed(st.iterations() * g.edgeCount());
+}
+
+void BM_KosarajuSCC(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), false);
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::kosarajuSCC(g));
+    st.SetItemsProcessed(st.iterations() * g.edgeCount());
+}
+
+void BM_ParallelSCC(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), false);
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::parallelSCC(g));
+    st.SetItemsProcessed(st.iterations() * g.edgeCount());
+}
+
+// Scale 20 (~8M/16M edges) by default; DS2025_BENCH_LARGE=1 adds scale 22 with ~100M edges
+// (about 2 GB peak for the SCC cases)
+const int registerComponents = [] {
+    std::vector<std::vector<int64_t>> sizes = {{20, 8}};
+    if (std::getenv("DS2025_BENCH_LARGE")) sizes.push_back({22, 24});
+    for (auto& s : sizes) {
+        int undirectedFactor = (int)s[1] / 2; // both directions stored: same edge count as the directed graph
+        benchmark::RegisterBenchmark("BM_ConnectedComponents", BM_ConnectedComponents)
+            ->Args({s[0], undirectedFactor})->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("BM_ConnectedComponentsBFS", BM_ConnectedComponentsBFS)
+            ->Args({s[0], undirectedFactor})->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("BM_TarjanSCC", BM_TarjanSCC)->Args(s)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("BM_KosarajuSCC", BM_KosarajuSCC)->Args(s)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("BM_ParallelSCC", BM_ParallelSCC)->Args(s)->Unit(benchmark::kMillisecond);
+    }
+    return 0;
+}();
+
+}  // namespace
+
+// All-pairs distances: one Dijkstra call per node (what callers did before) vs the engine
+static void BM_DijkstraEveryNode(benchmark::State& st) {
+    exp3::Graph g = randomGraph(120, 4);
+    MuteCout mute;
+    for (auto _ : st)
+        for (char c : g.nodes) exp3::Dijkstra(g, c);
+}
+BENCHMARK(BM_DijkstraEveryNode)->Unit(benchmark::kMillisecond);
+
+// arg: node count (ring plus 32 chords per node)
+static void BM_FloydWarshall(benchmark::State& st) {
+    exp3::Graph g = randomGraph((int)st.range(0), 32);
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::floydWarshall(g));
+    st.SetItemsProcessed(st.iterations() * st.range(0) * st.range(0) * st.range(0));
+}
+BENCHMARK(BM_FloydWarshall)->Arg(120)->Arg(512)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_FloydWarshallNaive(benchmark::State& st) {
+    exp3::Graph g = randomGraph((int)st.range(0), 32);
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::floydWarshallNaive(g));
+    st.SetItemsProcessed(st.iterations() * st.range(0) * st.range(0) * st.range(0));
+}
+BENCHMARK(BM_FloydWarshallNaive)->Arg(120)->Arg(512)->Unit(benchmark::kMillisecond);
+
+// args: R-MAT scale, edge factor; every node is a source
+static void BM_MultiSourceDijkstra(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), false);
+    std::vector<int32_t> sources(g.n);
+    for (int32_t v = 0; v < g.n; ++v) sources[v] = v;
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::multiSourceDijkstra(g, sources));
+    st.SetItemsProcessed(st.iterations() * g.n * g.edgeCount());
+}
+BENCHMARK(BM_MultiSourceDijkstra)->Args({10, 8})->Args({10, 64})->Unit(benchmark::kMillisecond);
+
+static void BM_FloydWarshallCsr(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), false);
+    for (auto _ : st) benchmark::DoNotOptimize(exp3::floydWarshall(g));
+    st.SetItemsProcessed(st.iterations() * (int64_t)g.n * g.n * g.n);
+}
+BENCHMARK(BM_FloydWarshallCsr)->Args({10, 8})->Args({10, 64})->Unit(benchmark::kMillisecond);
+
+// Iterative traversals; the traversal object is reused across iterations as callers would
+namespace {
+
+struct CountVisitor : exp3::TraversalVisitor {
+    int64_t discovered = 0, back = 0;
+    void discover(int32_t) { ++discovered; }
+    void backEdge(int32_t, int32_t) { ++back; }
+};
+
+}  // namespace
+
+// args: R-MAT scale, edge factor (directed)
+static void BM_DfsTraversal(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), false);
+    exp3::DfsTraversal dfs;
+    for (auto _ : st) {
+        CountVisitor v;
+        dfs.runAll(exp3::CsrAdjacency{g}, v);
+        benchmark::DoNotOptimize(v.back);
+    }
+    st.SetItemsProcessed(st.iterations() * g.edgeCount());
+}
+BENCHMARK(BM_DfsTraversal)->Args({20, 8})->Unit(benchmark::kMillisecond);
+
+static void BM_BfsTraversal(benchmark::State& st) {
+    const exp3::CsrGraph& g = rmatGraph((int)st.range(0), (int)st.range(1), false);
+    exp3::BfsTraversal bfs;
+    for (auto _ : st) {
+        CountVisitor v;
+        bfs.reset(g.n);
+        bfs.run(exp3::CsrAdjacency{g}, 0, v);
+        benchmark::DoNotOptimize(v.discovered);
+    }
+    st.SetItemsProcessed(st.iterations() * g.edgeCount());
+}
+BENCHMARK(BM_BfsTraversal)->Args({20, 8})->Unit(benchmark::kMillisecond);
+
+// arg: path length; recursion would need one stack frame per vertex
+static void BM_DfsLongPath(benchmark::State& st) {
+    int32_t n = (int32_t)st.range(0);
+    std::vector<uint32_t> src(n - 1), dst(n - 1);
+    std::vector<int> w(n - 1, 1);
+    for (int32_t i = 0; i + 1 < n; ++i) { src[i] = i; dst[i] = i + 1; }
+    exp3::CsrGraph g = exp3::csrFromEdges(n, src.data(), dst.data(), w.data(), src.size(), false);
+    exp3::DfsTraversal dfs;
+    for (auto _ : st) {
+        CountVisitor v;
+        dfs.reset(n);
+        dfs.run(exp3::CsrAdjacency{g}, 0, v);
+        benchmark::DoNotOptimize(v.discovered);
+    }
+    st.SetItemsProcessed(st.iterations() * n);
+}
+BENCHMARK(BM_DfsLongPath)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+// ========================= exp4: sorting + NMS =========================
+static void BM_NmsSort(benchmark::State& st) {
+    auto base = exp4::generateClusteredBoxes((int)st.range(1));
+    for (auto _ : st) {
+        st.PauseTiming(); auto boxes = base; st.ResumeTiming();
+        switch (st.range(0)) {
+            case 0: exp4::quickSort(boxes, 0, (int)boxes.size() - 1); break;
+            case 1: exp4::mergeSort(boxes, 0, (int)boxes.size() - 1); break;
+            case 2: exp4::heapSort(boxes); break;
+            default: exp4::bubbleSort(boxes); break;
+        }
+        benchmark::DoNotOptimize(boxes.data());
+    }
+}
+BENCHMARK(BM_NmsSort)->ArgNames({"sort", "n"})
+    ->Args({0, 10000})->Args({1, 10000})->Args({2, 10000})->Args({3, 2000});
+
+static void BM_Nms(benchmark::State& st) {
+    auto boxes = exp4::generateBoxes((int)st.range(0), st.range(1) != 0);
+    exp4::quickSort(boxes, 0, (int)boxes.size() - 1);
+    for (auto _ : st) benchmark::DoNotOptimize(exp4::nms(boxes));
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK(BM_Nms)->ArgNames({"n", "clustered"})->Args({1000, 0})->Args({10000, 0})
+    ->Args({1000, 1})->Args({2000, 1})->Args({5000, 1})->Args({10000, 1});
+
+namespace {
+
+// Boxes of `a` whose original index does not appear in `b`
+int keptOnlyIn(const std::vector<exp4::BoundingBox>& a, const std::vector<exp4::BoundingBox>& b) {
+    std::vector<int> ids;
+    for (auto& x : b) ids.push_back(x.index);
+    std::sort(ids.begin(), ids.end());
+    int n = 0;
+    for (auto& x : a) n += !std::binary_search(ids.begin(), ids.end(), x.index);
+    return n;
+}
+
+}  // namespace
+
+// Matrix NMS on K clustered boxes; arg 1: 0 = Fast-NMS, 1 = Cluster-NMS.
+// missed / extra count boxes kept by greedy nms() but not here, and the reverse.
+static void BM_MatrixNms(benchmark::State& st) {
+    int k = (int)st.range(0);
+    auto boxes = exp4::generateBoxes(k, true);
+    exp4::quickSort(boxes, 0, k - 1);
+    std::vector<exp4::BoundingBox> kept;
+    int iterations = 1;
+    for (auto _ : st) {
+        if (st.range(1)) kept = exp4::clusterNms(boxes, 0.5f, k, 1000, std::thread::hardware_concurrency(), &iterations);
+        else kept = exp4::fastNms(boxes, 0.5f, k);
+        benchmark::DoNotOptimize(kept.data());
+    }
+    auto greedy = exp4::nms(boxes);
+    st.counters["kept"] = (double)kept.size();
+    st.counters["missed"] = keptOnlyIn(greedy, kept);
+    st.counters["extra"] = keptOnlyIn(kept, greedy);
+    st.counters["iterations"] = iterations;
+    st.SetItemsProcessed(st.iterations() * k);
+}
+BENCHMARK(BM_MatrixNms)->ArgNames({"k", "cluster"})
+    ->Args({1000, 0})->Args({2000, 0})->Args({5000, 0})
+    ->Args({1000, 1})->Args({2000, 1})->Args({5000, 1})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
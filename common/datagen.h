@@ -0,0 +1,136 @@
+// datagen.h - deterministic synthetic data shared by the experiments
+//
+// Every value is a pure function of (seed, element index, draw number), so any element
+// can be produced on its own and a parallel fill is bit-identical to a serial one.
+// Generators write straight into storage the caller has already sized.
+#ifndef DATAGEN_H
+#define DATAGEN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ds2025::datagen {
+
+// splitmix64 finalizer
+inline uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Counter-based generator: draw k of element i
+class CounterRng {
+public:
+    explicit CounterRng(uint64_t seed) : key(mix64(seed)) {}
+
+    uint64_t bits(uint64_t i, uint64_t k = 0) const {
+        return mix64(key ^ mix64(i * 0xd1b54a32d192ed03ULL + k));
+    }
+
+    // uniform in [0, 1)
+    double uniform(uint64_t i, uint64_t k = 0) const { return (bits(i, k) >> 11) * 0x1.0p-53; }
+    double uniform(uint64_t i, uint64_t k, double lo, double hi) const { return lo + (hi - lo) * uniform(i, k); }
+
+    // unbiased integer in [0, n) (Lemire's multiply-shift; a rejected draw moves on to
+    // draw k + 64, so callers should keep their own draw numbers below 64); 0 when n == 0
+    uint64_t below(uint64_t i, uint64_t k, uint64_t n) const {
+        if (n == 0) return 0;
+        for (uint64_t kk = k; ; kk += 64) {
+            unsigned __int128 m = (unsigned __int128)bits(i, kk) * n;
+            uint64_t low = (uint64_t)m;
+            if (low >= n || low >= (0 - n) % n) return (uint64_t)(m >> 64);
+        }
+    }
+    // inclusive, lo <= hi; the span is taken modulo 2^64, so [INT64_MIN, INT64_MAX] is a full draw
+    int64_t range(uint64_t i, uint64_t k, int64_t lo, int64_t hi) const {
+        uint64_t span = (uint64_t)hi - (uint64_t)lo + 1;
+        return (int64_t)((uint64_t)lo + (span == 0 ? bits(i, k) : below(i, k, span)));
+    }
+
+private:
+    uint64_t key;
+};
+
+// Calls fn(i) for every i in [0, n), split into contiguous ranges over `threads` threads
+template <typename F>
+void parallelFill(size_t n, unsigned threads, F fn) {
+    threads = std::max(1u, std::min<unsigned>(threads, (unsigned)std::max<size_t>(1, n / 4096)));
+    size_t chunk = (n + threads - 1) / threads;
+    auto run = [&](size_t b) { for (size_t i = b; i < std::min(n, b + chunk); ++i) fn(i); };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(run, t * chunk);
+    run(0);
+    for (auto& th : pool) th.join();
+}
+
+inline unsigned defaultThreads() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+// ---- Complex points (exp1): both parts uniform in [0, vmax), rounded to 0.01 ----
+inline void complexAt(const CounterRng& rng, uint64_t i, double vmax, double& re, double& im) {
+    re = rng.below(i, 0, (uint64_t)(vmax * 100)) / 100.0;
+    im = rng.below(i, 1, (uint64_t)(vmax * 100)) / 100.0;
+}
+
+// SoA fill
+inline void fillComplex(double* re, double* im, size_t n, double vmax, uint64_t seed,
+                        unsigned threads = defaultThreads()) {
+    CounterRng rng(seed);
+    parallelFill(n, threads, [&](size_t i) { complexAt(rng, i, vmax, re[i], im[i]); });
+}
+
+// ---- Histogram heights (exp1): uniform integers in [lo, hi] ----
+inline void fillHeights(int* h, size_t n, int lo, int hi, uint64_t seed, unsigned threads = defaultThreads()) {
+    CounterRng rng(seed);
+    parallelFill(n, threads, [&](size_t i) { h[i] = (int)rng.range(i, 0, lo, hi); });
+}
+
+// ---- Bounding boxes (exp4) on an 800x600 image ----
+struct Box { float x1, y1, x2, y2, score; };
+
+// sides 20~119, score in steps of 0.001; clustered boxes put 80% of the corners
+// in the 200x200 square around the image centre
+inline Box boxAt(const CounterRng& rng, uint64_t i, bool clustered) {
+    float x1, y1;
+    if (clustered && rng.below(i, 0, 100) < 80) {
+        x1 = 300 + (float)rng.below(i, 1, 200);
+        y1 = 200 + (float)rng.below(i, 2, 200);
+    } else {
+        x1 = (float)rng.below(i, 1, 800);
+        y1 = (float)rng.below(i, 2, 600);
+    }
+    float w = 20 + (float)rng.below(i, 3, 100);
+    float h = 20 + (float)rng.below(i, 4, 100);
+    return {x1, y1, x1 + w, y1 + h, rng.below(i, 5, 1000) / 1000.0f};
+}
+
+// ---- Power-law graphs: R-MAT edge list ----
+// Edge i picks one quadrant per level with probabilities a, b, c, 1-a-b-c over a
+// 2^scale x 2^scale adjacency matrix; weights are uniform in [1, maxWeight].
+struct RmatParams { int scale; double a = 0.57, b = 0.19, c = 0.19; int maxWeight = 100; };
+
+inline void rmatEdgeAt(const CounterRng& rng, uint64_t i, const RmatParams& p, uint32_t& u, uint32_t& v, int& w) {
+    u = v = 0;
+    for (int level = 0; level < p.scale; ++level) {
+        double r = rng.uniform(i, level);
+        u <<= 1; v <<= 1;
+        if (r < p.a) {}
+        else if (r < p.a + p.b) v |= 1;
+        else if (r < p.a + p.b + p.c) u |= 1;
+        else { u |= 1; v |= 1; }
+    }
+    w = (int)rng.range(i, 63, 1, p.maxWeight);
+}
+
+inline void fillRmatEdges(uint32_t* src, uint32_t* dst, int* weight, size_t m, const RmatParams& p, uint64_t seed,
+                          unsigned threads = defaultThreads()) {
+    CounterRng rng(seed);
+    parallelFill(m, threads, [&](size_t i) { rmatEdgeAt(rng, i, p, src[i], dst[i], weight[i]); });
+}
+
+}  // namespace ds2025::datagen
+
+#endif
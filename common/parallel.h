@@ -0,0 +1,34 @@
+// parallel.h - dynamically scheduled parallel loop shared by the graph algorithms
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ds2025::common {
+
+// Calls fn(begin, end) over [0, n) in chunks of `grain` handed out on demand, which keeps
+// threads balanced when per-item cost is skewed (power-law degrees, uneven blocks)
+template <typename F>
+void parallelChunks(int64_t n, unsigned threads, int64_t grain, F fn) {
+    threads = (unsigned)std::max<int64_t>(1, std::min<int64_t>(threads, (n + grain - 1) / grain));
+    std::atomic<int64_t> next{0};
+    auto run = [&] {
+        for (;;) {
+            int64_t b = next.fetch_add(grain, std::memory_order_relaxed);
+            if (b >= n) return;
+            fn(b, std::min(n, b + grain));
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(run);
+    run();
+    for (auto& th : pool) th.join();
+}
+
+}  // namespace ds2025::common
+
+#endif
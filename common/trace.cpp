@@ -0,0 +1,215 @@
+// trace.cpp
+#include "trace.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+using namespace std;
+
+namespace ds2025::trace {
+namespace {
+
+struct Event {
+    int id;
+    uint64_t begin, end;
+};
+
+struct ScopeStats {
+    uint64_t calls = 0, total = 0, max = 0;
+};
+
+struct ThreadBuffer {
+    int tid;
+    mutex m;  // owner vs. exporter; uncontended on the recording path
+    vector<Event> events;
+    uint64_t dropped = 0;
+    ScopeStats stats[kMaxScopes];
+    ThreadCounters counters{};
+};
+
+struct Registry {
+    mutex m;
+    const char* scopeNames[kMaxScopes];
+    int scopeCount = 0;
+    const char* counterNames[kMaxCounters];
+    int counterCount = 0;
+    vector<unique_ptr<ThreadBuffer>> threads;
+    uint64_t originTicks = ticks();
+    chrono::steady_clock::time_point originTime = chrono::steady_clock::now();
+};
+
+// Never destroyed: threads and static destructors may still record during exit
+Registry& registry() {
+    static Registry* r = new Registry;
+    return *r;
+}
+
+thread_local ThreadBuffer* localBuffer = nullptr;
+
+ThreadBuffer& buffer() {
+    if (!localBuffer) {
+        Registry& r = registry();
+        lock_guard<mutex> lk(r.m);
+        r.threads.emplace_back(new ThreadBuffer);
+        localBuffer = r.threads.back().get();
+        localBuffer->tid = (int)r.threads.size();
+    }
+    return *localBuffer;
+}
+
+int intern(const char** names, int& count, int limit, const char* name) {
+    for (int i = 0; i < count; ++i)
+        if (strcmp(names[i], name) == 0) return i;
+    if (count == limit) return limit - 1;
+    names[count] = name;
+    return count++;
+}
+
+// tick rate measured against steady_clock since the registry was created
+double ticksPerMicro(const Registry& r) {
+    auto minSpan = chrono::milliseconds(10);
+    auto elapsed = chrono::steady_clock::now() - r.originTime;
+    if (elapsed < minSpan) this_thread::sleep_for(minSpan - elapsed);
+    uint64_t t = ticks();
+    double us = chrono::duration<double, micro>(chrono::steady_clock::now() - r.originTime).count();
+    return (t - r.originTicks) / us;
+}
+
+void writeName(ostream& os, const char* s) {
+    os << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') os << '\\';
+        os << *s;
+    }
+    os << '"';
+}
+
+#ifdef DS2025_TRACE
+struct ExitDump {
+    ~ExitDump() {
+        if (const char* path = getenv("DS2025_TRACE_FILE")) writeChromeTrace(string(path));
+        if (getenv("DS2025_TRACE_SUMMARY")) printSummary(cerr);
+    }
+} exitDump;
+#endif
+
+}  // namespace
+
+int scopeId(const char* name) {
+    Registry& r = registry();
+    lock_guard<mutex> lk(r.m);
+    return intern(r.scopeNames, r.scopeCount, kMaxScopes, name);
+}
+
+int counterId(const char* name) {
+    Registry& r = registry();
+    lock_guard<mutex> lk(r.m);
+    return intern(r.counterNames, r.counterCount, kMaxCounters, name);
+}
+
+ThreadCounters& localCounters() { return buffer().counters; }
+
+void recordScope(int id, uint64_t begin, uint64_t end) {
+    ThreadBuffer& b = buffer();
+    lock_guard<mutex> lk(b.m);
+    ScopeStats& s = b.stats[id];
+    uint64_t d = end - begin;
+    ++s.calls;
+    s.total += d;
+    if (d > s.max) s.max = d;
+    if (b.events.size() < kMaxEventsPerThread) b.events.push_back({id, begin, end});
+    else ++b.dropped;
+}
+
+void writeChromeTrace(ostream& os) {
+    Registry& r = registry();
+    double rate = ticksPerMicro(r);
+    lock_guard<mutex> lk(r.m);
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto sep = [&] { os << (first ? "\n" : ",\n"); first = false; };
+    os << fixed << setprecision(3);
+    vector<uint64_t> totals(r.counterCount, 0);
+    for (auto& t : r.threads) {
+        lock_guard<mutex> tl(t->m);
+        sep();
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t->tid
+           << ",\"args\":{\"name\":\"thread " << t->tid << "\"}}";
+        for (const Event& e : t->events) {
+            sep();
+            os << "{\"name\":";
+            writeName(os, r.scopeNames[e.id]);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << t->tid
+               << ",\"ts\":" << (e.begin - r.originTicks) / rate << ",\"dur\":" << (e.end - e.begin) / rate << "}";
+        }
+        for (int c = 0; c < r.counterCount; ++c) totals[c] += t->counters.v[c].load(memory_order_relaxed);
+    }
+    double now = (ticks() - r.originTicks) / rate;
+    for (int c = 0; c < r.counterCount; ++c) {
+        sep();
+        os << "{\"name\":";
+        writeName(os, r.counterNames[c]);
+        os << ",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << now << ",\"args\":{\"value\":" << totals[c] << "}}";
+    }
+    os << "\n]}\n";
+    os.unsetf(ios::floatfield);
+}
+
+bool writeChromeTrace(const string& path) {
+    ofstream f(path);
+    if (!f) return false;
+    writeChromeTrace(f);
+    return bool(f);
+}
+
+void printSummary(ostream& os) {
+    Registry& r = registry();
+    double rate = ticksPerMicro(r);
+    lock_guard<mutex> lk(r.m);
+    vector<ScopeStats> stats(r.scopeCount);
+    vector<uint64_t> totals(r.counterCount, 0);
+    uint64_t dropped = 0;
+    for (auto& t : r.threads) {
+        lock_guard<mutex> tl(t->m);
+        for (int i = 0; i < r.scopeCount; ++i) {
+            stats[i].calls += t->stats[i].calls;
+            stats[i].total += t->stats[i].total;
+            stats[i].max = max(stats[i].max, t->stats[i].max);
+        }
+        for (int c = 0; c < r.counterCount; ++c) totals[c] += t->counters.v[c].load(memory_order_relaxed);
+        dropped += t->dropped;
+    }
+    ios::fmtflags flags = os.flags();
+    os << left << setw(28) << "scope" << right << setw(12) << "calls" << setw(14) << "total ms"
+       << setw(12) << "mean us" << setw(12) << "max us" << "\n" << fixed << setprecision(3);
+    for (int i = 0; i < r.scopeCount; ++i) {
+        const ScopeStats& s = stats[i];
+        if (!s.calls) continue;
+        os << left << setw(28) << r.scopeNames[i] << right << setw(12) << s.calls
+           << setw(14) << s.total / rate / 1000 << setw(12) << s.total / rate / s.calls
+           << setw(12) << s.max / rate << "\n";
+    }
+    for (int c = 0; c < r.counterCount; ++c)
+        os << left << setw(28) << r.counterNames[c] << right << setw(12) << totals[c] << "\n";
+    if (dropped) os << "(" << dropped << " events over the per-thread limit kept only in the summary)\n";
+    os.flags(flags);
+}
+
+// Meant for quiescent points: a thread counting concurrently may lose its last update
+void reset() {
+    Registry& r = registry();
+    lock_guard<mutex> lk(r.m);
+    for (auto& t : r.threads) {
+        lock_guard<mutex> tl(t->m);
+        t->events.clear();
+        t->dropped = 0;
+        for (auto& s : t->stats) s = ScopeStats();
+        for (auto& c : t->counters.v) c.store(0, memory_order_relaxed);
+    }
+}
+
+}  // namespace ds2025::trace
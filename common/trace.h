@@ -0,0 +1,127 @@
+// trace.h - compile-time switchable scoped timers and counters
+//
+// Built with DS2025_TRACE defined, TRACE_SCOPE(name) records one complete event per
+// scope and TRACE_COUNT(name, n) adds n to a named counter. Both only touch the calling
+// thread's buffer; names must be string literals. Without DS2025_TRACE the macros expand
+// to nothing, so hot loops should count into a local and report it once per call.
+//
+// Export with writeChromeTrace (chrome://tracing / Perfetto JSON) or printSummary.
+// When tracing is compiled in, a program also writes $DS2025_TRACE_FILE and prints the
+// summary to stderr if $DS2025_TRACE_SUMMARY is set, at exit.
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace ds2025::trace {
+
+constexpr int kMaxScopes = 256;
+constexpr int kMaxCounters = 64;
+constexpr size_t kMaxEventsPerThread = 1 << 20;  // later events only update the summary
+
+// rdtsc where available, steady_clock nanoseconds otherwise
+inline uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+// name -> small id, registered once per call site (ids past the limit share the last slot)
+int scopeId(const char* name);
+int counterId(const char* name);
+
+// Counters of one thread; only the owner writes, readers load relaxed
+struct ThreadCounters {
+    std::atomic<uint64_t> v[kMaxCounters];
+};
+ThreadCounters& localCounters();
+
+inline void addCount(int id, uint64_t n) {
+    std::atomic<uint64_t>& c = localCounters().v[id];
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+void recordScope(int id, uint64_t begin, uint64_t end);
+
+class Scope {
+public:
+    explicit Scope(int id) : id(id), begin(ticks()) {}
+    ~Scope() { recordScope(id, begin, ticks()); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    int id;
+    uint64_t begin;
+};
+
+// Chrome trace-event JSON: one "X" event per recorded scope, final counter values as "C" events
+void writeChromeTrace(std::ostream& os);
+bool writeChromeTrace(const std::string& path);
+
+// Per scope: calls, total / mean / max time; then counter totals (all threads)
+void printSummary(std::ostream& os);
+
+// Drop all events, scope statistics and counter values
+void reset();
+
+// Prints the summary every `every` until destroyed
+class PeriodicSummary {
+public:
+    PeriodicSummary(std::chrono::milliseconds every, std::ostream& os) : every(every), os(os) {
+        worker = std::thread([this] { run(); });
+    }
+    ~PeriodicSummary() {
+        {
+            std::lock_guard<std::mutex> lk(m);
+            stop = true;
+        }
+        cv.notify_one();
+        worker.join();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lk(m);
+        while (!cv.wait_for(lk, every, [this] { return stop; })) printSummary(os);
+    }
+
+    std::chrono::milliseconds every;
+    std::ostream& os;
+    std::mutex m;
+    std::condition_variable cv;
+    bool stop = false;
+    std::thread worker;
+};
+
+}  // namespace ds2025::trace
+
+#ifdef DS2025_TRACE
+#define TRACE_CAT_(a, b) a##b
+#define TRACE_CAT(a, b) TRACE_CAT_(a, b)
+#define TRACE_SCOPE(name)                                                                 \
+    static const int TRACE_CAT(traceScopeId_, __LINE__) = ::ds2025::trace::scopeId(name); \
+    ::ds2025::trace::Scope TRACE_CAT(traceScope_, __LINE__)(TRACE_CAT(traceScopeId_, __LINE__))
+#define TRACE_COUNT(name, n)                                                              \
+    do {                                                                                  \
+        static const int traceCounterId_ = ::ds2025::trace::counterId(name);              \
+        ::ds2025::trace::addCount(traceCounterId_, (n));                                  \
+    } while (0)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_COUNT(name, n) ((void)sizeof(n))  // keeps local tallies "used"; not evaluated
+#endif
+
+#endif
@@ -0,0 +1,327 @@
+// calculator.cpp
+#include "calculator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include "../common/trace.h"
+using namespace std;
+
+namespace ds2025::exp1 {
+
+bool isOp(char c) {
+    return c=='+' || c=='-' || c=='*' || c=='/' || c=='^';
+}
+
+int prec(char op) {
+    if (op=='+' || op=='-') return 1;
+    if (op=='*' || op=='/') return 2;
+    if (op=='u') return 3;
+    if (op=='^') return 4;
+    return 0;
+}
+
+double applyOp(double a, double b, char op) {
+    if (op=='+') return a + b;
+    if (op=='-') return a - b;
+    if (op=='*') return a * b;
+    if (op=='/') return a / b;
+    if (op=='^') return pow(a, b);
+    throw runtime_error("Unknown op");
+}
+
+static void emitOp(CompiledExpr& e, char op) {
+    auto& c = e.code;
+    size_t n = c.size();
+    if (op == 'u') {
+        if (n >= 1 && c[n-1].kind == Instr::PushConst) c[n-1].val = -c[n-1].val;
+        else c.push_back({Instr::Neg, 'u', 0, -1});
+        return;
+    }
+    if (n >= 2 && c[n-1].kind == Instr::PushConst && c[n-2].kind == Instr::PushConst) {
+        c[n-2].val = applyOp(c[n-2].val, c[n-1].val, op);
+        c.pop_back();
+    } else if (n >= 1 && c[n-1].kind == Instr::PushConst) {
+        c[n-1].kind = Instr::OpConst; c[n-1].op = op;
+    } else if (n >= 1 && c[n-1].kind == Instr::PushVar) {
+        c[n-1].kind = Instr::OpVar; c[n-1].op = op;
+    } else {
+        c.push_back({Instr::Op, op, 0, -1});
+    }
+}
+
+const char* tryCompile(const string& s, CompiledExpr& e, int* errPos) {
+    e = CompiledExpr();
+    int i = 0, n = (int)s.size();
+    e.code.reserve(n);              // at most one instruction per input character
+    vector<char> ops;
+    ops.reserve(n);
+    bool expectOperand = true;
+    auto fail = [&](const char* msg) { if (errPos) *errPos = i; return msg; };
+    while (i < n) {
+        if (isspace((unsigned char)s[i])) { ++i; continue; }
+        if (s[i]=='(') {
+            if (!expectOperand) return fail("Missing operator before '('");
+            ops.push_back('('); ++i;
+        } else if (isdigit((unsigned char)s[i]) || s[i]=='.') {
+            if (!expectOperand) return fail("Missing operator before number");
+            int j = i;
+            while (j < n && (isdigit((unsigned char)s[j]) || s[j]=='.')) ++j;
+            char* end = nullptr;
+            double val = strtod(s.c_str() + i, &end);
+            if (end != s.c_str() + j) return fail("Malformed number");
+            e.code.push_back({Instr::PushConst, 0, val, -1});
+            expectOperand = false;
+            i = j;
+        } else if (isalpha((unsigned char)s[i]) || s[i]=='_') {
+            if (!expectOperand) return fail("Missing operator before variable");
+            int j = i;
+            while (j < n && (isalnum((unsigned char)s[j]) || s[j]=='_')) ++j;
+            int id = 0;             // compare names in place instead of building a substring
+            while (id < (int)e.vars.size() && s.compare(i, j-i, e.vars[id]) != 0) ++id;
+            if (id == (int)e.vars.size()) e.vars.emplace_back(s, i, j-i);
+            e.code.push_back({Instr::PushVar, 0, 0, id});
+            expectOperand = false;
+            i = j;
+        } else if (s[i]==')') {
+            if (expectOperand) return fail("Missing operand before ')'");
+            while (!ops.empty() && ops.back()!='(') { emitOp(e, ops.back()); ops.pop_back(); }
+            if (ops.empty()) return fail("Unbalanced ')'");
+            ops.pop_back();
+            ++i;
+        } else if (isOp(s[i])) {
+            if (expectOperand) {
+                // unary minus is a prefix operator: it never pops anything
+                if (s[i] != '-') return fail("Missing operand before operator");
+                ops.push_back('u');
+            } else {
+                while (!ops.empty() && prec(ops.back()) >= prec(s[i])) { emitOp(e, ops.back()); ops.pop_back(); }
+                ops.push_back(s[i]);
+                expectOperand = true;
+            }
+            ++i;
+        } else {
+            return fail("Invalid character");
+        }
+    }
+    if (expectOperand) return fail(e.code.empty() && ops.empty() ? "Empty expression" : "Missing operand");
+    while (!ops.empty()) {
+        if (ops.back()=='(') return fail("Unbalanced '('");
+        emitOp(e, ops.back()); ops.pop_back();
+    }
+    int depth = 0;
+    for (auto& in : e.code) {
+        if (in.kind == Instr::PushConst || in.kind == Instr::PushVar) ++depth;
+        else if (in.kind == Instr::Op) --depth;
+        e.maxDepth = max(e.maxDepth, depth);
+    }
+    return nullptr;
+}
+
+CompiledExpr compile(const string& s) {
+    CompiledExpr e;
+    int pos = 0;
+    if (const char* err = tryCompile(s, e, &pos))
+        throw runtime_error(string(err) + " at position " + to_string(pos));
+    return e;
+}
+
+// Expressions up to this operand depth evaluate on a stack array; deeper ones use the heap
+static const int kLocalDepth = 32;
+
+double evalCompiled(const CompiledExpr& e, const double* vals) {
+    double local[kLocalDepth];
+    vector<double> deep;
+    double* st = local;
+    if (e.maxDepth > kLocalDepth) { deep.resize(e.maxDepth); st = deep.data(); }
+    int top = -1;
+    for (auto& in : e.code) {
+        switch (in.kind) {
+            case Instr::PushConst: st[++top] = in.val; break;
+            case Instr::PushVar:   st[++top] = vals[in.var]; break;
+            case Instr::Neg:       st[top] = -st[top]; break;
+            case Instr::OpConst:   st[top] = applyOp(st[top], in.val, in.op); break;
+            case Instr::OpVar:     st[top] = applyOp(st[top], vals[in.var], in.op); break;
+            case Instr::Op:
+                --top;
+                st[top] = applyOp(st[top], st[top + 1], in.op);
+                break;
+        }
+    }
+    return st[top];
+}
+
+double evaluate(const string& s) {
+    TRACE_SCOPE("evaluate");
+    CompiledExpr e = compile(s);
+    TRACE_COUNT("evaluate.instrs", e.code.size());
+    if (!e.vars.empty()) throw runtime_error("Unbound variable: " + e.vars[0]);
+    return evalCompiled(e);
+}
+
+// ---------- Column evaluation ----------
+// Rows are processed in blocks of kBlock so every stack slot stays in L1;
+// intermediates only ever live in those block buffers, never as full columns.
+static const int kBlock = 256;
+
+static inline uint64_t bitsOf(double x) { uint64_t u; memcpy(&u, &x, sizeof u); return u; }
+static inline double fromBits(uint64_t u) { double x; memcpy(&x, &u, sizeof x); return x; }
+
+// ln 2 split so that k * kLn2Hi is exact for |k| < 2^20
+static const double kLn2Hi = 0x1.62e42feep-1, kLn2Lo = 0x1.a39ef35793c76p-33;
+
+// Blocked pow as exp(b * log a) with both halves reduced to short polynomials, written
+// branch-free so the main loop vectorizes like the other kernels instead of making one
+// libm call per row. It agrees with pow to a few ulp times |b log a|. Rows outside the
+// range it handles (a not a positive normal, |b log a| > 700, NaN) go to libm pow.
+static void powKernel(double* d, const double* a, const double* b, int n) {
+    double y[kBlock], r[kBlock];
+    for (int i = 0; i < n; ++i) {
+        // a = m * 2^k with m in [sqrt(1/2), sqrt(2)); the halving is done on the bits so the
+        // loop stays free of floating-point selects the compiler will not if-convert
+        uint64_t u = bitsOf(a[i]);
+        uint64_t mant = u & 0x000fffffffffffffULL;
+        uint64_t big = (mant + (0x0010000000000000ULL - 0x6a09e667f3bceULL)) >> 52;   // m > sqrt(2)
+        double m = fromBits(mant | (0x3ff0000000000000ULL - (big << 52)));
+        double k = fromBits(0x4330000000000000ULL | ((u >> 52) + big)) - 0x1p52 - 1023;
+        // log m = 2 atanh(s) = 2s (1 + s^2/3 + s^4/5 + ...), |s| < 0.172
+        double s = (m - 1) / (m + 1), s2 = s * s;
+        double p = 1.0 / 21;
+        p = p * s2 + 1.0 / 19; p = p * s2 + 1.0 / 17; p = p * s2 + 1.0 / 15;
+        p = p * s2 + 1.0 / 13; p = p * s2 + 1.0 / 11; p = p * s2 + 1.0 / 9;
+        p = p * s2 + 1.0 / 7;  p = p * s2 + 1.0 / 5;  p = p * s2 + 1.0 / 3;
+        p = p * s2 + 1;
+        double yi = b[i] * (k * kLn2Hi + (k * kLn2Lo + 2 * s * p));
+        // exp(y) = 2^j * exp(t), |t| <= ln2 / 2; j is read back from the low mantissa bits of jr
+        double jr = yi * 1.4426950408889634 + 0x1.8p52;
+        double j = jr - 0x1.8p52;
+        double t = (yi - j * kLn2Hi) - j * kLn2Lo;
+        double q = 1.0 / 6227020800;
+        q = q * t + 1.0 / 479001600; q = q * t + 1.0 / 39916800; q = q * t + 1.0 / 3628800;
+        q = q * t + 1.0 / 362880;    q = q * t + 1.0 / 40320;    q = q * t + 1.0 / 5040;
+        q = q * t + 1.0 / 720;       q = q * t + 1.0 / 120;      q = q * t + 1.0 / 24;
+        q = q * t + 1.0 / 6;         q = q * t + 0.5;            q = q * t + 1;
+        q = q * t + 1;
+        y[i] = yi;
+        r[i] = fromBits(bitsOf(q) + (bitsOf(jr) << 52));
+    }
+    for (int i = 0; i < n; ++i)
+        d[i] = a[i] >= DBL_MIN && a[i] <= DBL_MAX && fabs(y[i]) <= 700 ? r[i] : pow(a[i], b[i]);
+}
+
+// d may alias a (in-place update); the loops are written to auto-vectorize
+static void binKernel(double* d, const double* a, const double* b, int n, char op) {
+    switch (op) {
+        case '+': for (int i = 0; i < n; ++i) d[i] = a[i] + b[i]; break;
+        case '-': for (int i = 0; i < n; ++i) d[i] = a[i] - b[i]; break;
+        case '*': for (int i = 0; i < n; ++i) d[i] = a[i] * b[i]; break;
+        case '/': for (int i = 0; i < n; ++i) d[i] = a[i] / b[i]; break;
+        case '^': powKernel(d, a, b, n); break;
+        default: throw runtime_error("Unknown op");
+    }
+}
+
+static void constKernel(double* d, const double* a, double c, int n, char op) {
+    switch (op) {
+        case '+': for (int i = 0; i < n; ++i) d[i] = a[i] + c; break;
+        case '-': for (int i = 0; i < n; ++i) d[i] = a[i] - c; break;
+        case '*': for (int i = 0; i < n; ++i) d[i] = a[i] * c; break;
+        case '/': for (int i = 0; i < n; ++i) d[i] = a[i] / c; break;
+        case '^':
+            // exponents with an exactly rounded closed form skip the polynomial kernel
+            if (c == 2) { for (int i = 0; i < n; ++i) d[i] = a[i] * a[i]; }
+            else if (c == 1) { for (int i = 0; i < n; ++i) d[i] = a[i]; }
+            else if (c == -1) { for (int i = 0; i < n; ++i) d[i] = 1.0 / a[i]; }
+            else {
+                double cs[kBlock];
+                fill(cs, cs + n, c);
+                powKernel(d, a, cs, n);
+            }
+            break;
+        default: throw runtime_error("Unknown op");
+    }
+}
+
+void evaluateColumns(const CompiledExpr& e, const vector<const double*>& cols, size_t n, double* out) {
+    if (cols.size() < e.vars.size()) throw runtime_error("Missing column for variable");
+    int depth = max(e.maxDepth, 1);
+    vector<double> buf((size_t)depth * kBlock);
+    vector<const double*> slot(depth); // a slot either aliases an input column or owns its block buffer
+    for (size_t base = 0; base < n; base += kBlock) {
+        int len = (int)min<size_t>(kBlock, n - base);
+        int top = -1;
+        for (auto& in : e.code) {
+            double* own = top >= 0 ? &buf[(size_t)top * kBlock] : nullptr;
+            switch (in.kind) {
+                case Instr::PushConst: {
+                    ++top;
+                    double* d = &buf[(size_t)top * kBlock];
+                    fill(d, d + len, in.val);
+                    slot[top] = d;
+                    break;
+                }
+                case Instr::PushVar:
+                    slot[++top] = cols[in.var] + base;
+                    break;
+                case Instr::Neg:
+                    for (int i = 0; i < len; ++i) own[i] = -slot[top][i];
+                    slot[top] = own;
+                    break;
+                case Instr::OpConst:
+                    constKernel(own, slot[top], in.val, len, in.op);
+                    slot[top] = own;
+                    break;
+                case Instr::OpVar:
+                    binKernel(own, slot[top], cols[in.var] + base, len, in.op);
+                    slot[top] = own;
+                    break;
+                case Instr::Op: {
+                    double* d = &buf[(size_t)(top - 1) * kBlock];
+                    binKernel(d, slot[top - 1], slot[top], len, in.op);
+                    slot[--top] = d;
+                    break;
+                }
+            }
+        }
+        copy(slot[0], slot[0] + len, out + base);
+    }
+}
+
+vector<double> evaluateColumns(const string& s, const unordered_map<string, vector<double>>& cols) {
+    CompiledExpr e = compile(s);
+    vector<const double*> ptrs;
+    size_t n = cols.empty() ? 1 : cols.begin()->second.size();
+    for (auto& name : e.vars) {
+        auto it = cols.find(name);
+        if (it == cols.end()) throw runtime_error("Unbound variable: " + name);
+        if (it->second.size() != n) throw runtime_error("Column length mismatch: " + name);
+        ptrs.push_back(it->second.data());
+    }
+    vector<double> out(n);
+    evaluateColumns(e, ptrs, n, out.data());
+    return out;
+}
+
+void evaluateBatch(const string* exprs, size_t n, EvalResult* out, ThreadPool& pool, ParseCache& cache) {
+    pool.parallelFor(n, 256, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) {
+            ParseCache::Lookup en = cache.lookup(exprs[i]);
+            if (en.error) out[i] = {0, en.error};
+            else if (!en.expr->vars.empty()) out[i] = {0, "Unbound variable"};
+            else out[i] = {evalCompiled(*en.expr), nullptr};
+        }
+    });
+}
+
+vector<EvalResult> evaluateBatch(const vector<string>& exprs, ThreadPool& pool, ParseCache& cache) {
+    vector<EvalResult> out(exprs.size());
+    evaluateBatch(exprs.data(), exprs.size(), out.data(), pool, cache);
+    return out;
+}
+
+}  // namespace ds2025::exp1
@@ -0,0 +1,220 @@
+// calculator.h - infix expression compiler, scalar/column/batch evaluation (exp1 part 2)
+#ifndef CALCULATOR_H
+#define CALCULATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ds2025::exp1 {
+
+// Helper: determine if a char is operator
+bool isOp(char c);
+
+// 'u' is the internal unary minus: binds tighter than * and /, looser than ^ (-2^2 = -4)
+int prec(char op);
+
+// apply operator to two operands (double)
+double applyOp(double a, double b, char op);
+
+// ---------- Compiled (postfix) form ----------
+// An operand that directly feeds an operator is fused into it (OpConst / OpVar),
+// and operators over two constants are folded at compile time.
+struct Instr {
+    enum Kind { PushConst, PushVar, Op, OpConst, OpVar, Neg } kind;
+    char op;
+    double val;
+    int var;
+};
+
+struct CompiledExpr {
+    std::vector<Instr> code;
+    std::vector<std::string> vars;  // variable names, index = Instr::var
+    int maxDepth = 0;     // operand stack slots needed
+};
+
+// Shunting-yard over numbers, identifiers, + - * / ^, parentheses and unary minus.
+// Returns nullptr on success, otherwise a static error message; never throws.
+// Allocates only for e.code, e.vars and the operator stack (each reserved up front).
+const char* tryCompile(const std::string& s, CompiledExpr& e, int* errPos = nullptr);
+
+// throwing wrapper around tryCompile
+CompiledExpr compile(const std::string& s);
+
+// Scalar evaluation of a compiled expression; vals[v] is the value of variable v
+double evalCompiled(const CompiledExpr& e, const double* vals = nullptr);
+
+// Evaluate infix expression (supports parentheses and unary minus)
+double evaluate(const std::string& s);
+
+// ---------- Column evaluation ----------
+// Rows are processed in 256-row blocks so every stack slot stays in L1;
+// intermediates only ever live in those block buffers, never as full columns.
+
+// cols[v] points to n values of variable e.vars[v]; out receives n results
+void evaluateColumns(const CompiledExpr& e, const std::vector<const double*>& cols, size_t n, double* out);
+
+std::vector<double> evaluateColumns(const std::string& s, const std::unordered_map<std::string, std::vector<double>>& cols);
+
+// ---------- Batch evaluation ----------
+// Fixed set of worker threads reused across batches; the calling thread also takes chunks.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned n = std::thread::hardware_concurrency()) {
+        for (unsigned t = 1; t < std::max(n, 1u); ++t) workers.emplace_back([this]{ workerLoop(); });
+    }
+    ~ThreadPool() {
+        { std::lock_guard<std::mutex> lk(m); stopping = true; }
+        cv.notify_all();
+        for (auto& w : workers) w.join();
+    }
+    size_t size() const { return workers.size() + 1; }
+
+    // fn(begin, end) over [0, n) in chunks of `grain`; returns when every chunk is done
+    void parallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+        if (n == 0) return;
+        grain = std::max<size_t>(grain, 1);
+        {
+            std::lock_guard<std::mutex> lk(m);
+            job = &fn; jobSize = n; jobGrain = grain;
+            next = 0; active = workers.size();
+            ++generation;
+        }
+        cv.notify_all();
+        runChunks(fn, n, grain);
+        std::unique_lock<std::mutex> lk(m);
+        done.wait(lk, [this]{ return active == 0; });
+        job = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex m;
+    std::condition_variable cv, done;
+    const std::function<void(size_t, size_t)>* job = nullptr;
+    size_t jobSize = 0, jobGrain = 1, active = 0;
+    std::atomic<size_t> next{0};
+    unsigned long long generation = 0;
+    bool stopping = false;
+
+    void runChunks(const std::function<void(size_t, size_t)>& fn, size_t n, size_t grain) {
+        for (size_t b; (b = next.fetch_add(grain)) < n; ) fn(b, std::min(n, b + grain));
+    }
+    void workerLoop() {
+        unsigned long long seen = 0;
+        for (;;) {
+            const std::function<void(size_t, size_t)>* fn;
+            size_t n, grain;
+            {
+                std::unique_lock<std::mutex> lk(m);
+                cv.wait(lk, [&]{ return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                fn = job; n = jobSize; grain = jobGrain;
+            }
+            runChunks(*fn, n, grain);
+            std::lock_guard<std::mutex> lk(m);
+            if (--active == 0) done.notify_one();
+        }
+    }
+};
+
+// Compiled forms keyed by the expression text, split into independently locked shards.
+// Failed parses are cached too, so a repeated bad input costs one lookup. A full shard
+// evicts one entry chosen by CLOCK: hits set a reference bit, and the hand clears set bits
+// as it passes and evicts the first entry whose bit is already clear.
+class ParseCache {
+public:
+    struct Lookup {
+        std::shared_ptr<const CompiledExpr> expr;   // null when the parse failed
+        const char* error = nullptr;
+    };
+
+    explicit ParseCache(size_t capacityPerShard = 1 << 14) : cap(std::max<size_t>(capacityPerShard, 1)) {}
+
+    // A hit copies only the shared_ptr and marks the entry as recently used
+    Lookup lookup(const std::string& s) {
+        Shard& sh = shards[std::hash<std::string>()(s) % kShards];
+        {
+            std::shared_lock<std::shared_mutex> lk(sh.m);
+            auto it = sh.index.find(s);
+            if (it != sh.index.end()) {
+                Entry& en = sh.entries[it->second];
+                en.referenced.store(true, std::memory_order_relaxed);
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return {en.expr, en.error};
+            }
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+        Lookup res;
+        auto e = std::make_shared<CompiledExpr>();
+        res.error = tryCompile(s, *e);
+        if (!res.error) res.expr = std::move(e);
+        std::unique_lock<std::shared_mutex> lk(sh.m);
+        if (sh.index.count(s)) return res;   // another thread inserted it meanwhile
+        size_t slot;
+        if (sh.entries.size() < cap) {
+            slot = sh.entries.size();
+            sh.entries.emplace_back();
+        } else {
+            while (sh.entries[sh.hand].referenced.exchange(false, std::memory_order_relaxed))
+                sh.hand = (sh.hand + 1) % cap;
+            slot = sh.hand;
+            sh.hand = (sh.hand + 1) % cap;
+            sh.index.erase(sh.entries[slot].src);
+        }
+        Entry& en = sh.entries[slot];
+        en.src = s;
+        en.expr = res.expr;
+        en.error = res.error;
+        en.referenced.store(false, std::memory_order_relaxed);
+        sh.index.emplace(en.src, slot);
+        return res;
+    }
+
+    size_t hitCount() const { return hits.load(); }
+    size_t missCount() const { return misses.load(); }
+
+private:
+    struct Entry {
+        std::string src;
+        std::shared_ptr<const CompiledExpr> expr;
+        const char* error = nullptr;
+        std::atomic<bool> referenced{false};        // set by hits under the shared lock
+    };
+    static const int kShards = 64;
+    struct Shard {
+        std::shared_mutex m;
+        std::deque<Entry> entries;                          // never moved, so the index can view src
+        std::unordered_map<std::string_view, size_t> index; // src -> position in entries
+        size_t hand = 0;                                    // CLOCK hand over entries
+    };
+    Shard shards[kShards];
+    size_t cap;
+    std::atomic<size_t> hits{0}, misses{0};
+};
+
+struct EvalResult {
+    double value = 0;
+    const char* error = nullptr; // nullptr on success
+};
+
+// Evaluates exprs[0..n) into out[0..n); errors are reported per entry, nothing throws
+void evaluateBatch(const std::string* exprs, size_t n, EvalResult* out, ThreadPool& pool, ParseCache& cache);
+
+std::vector<EvalResult> evaluateBatch(const std::vector<std::string>& exprs, ThreadPool& pool, ParseCache& cache);
+
+}  // namespace ds2025::exp1
+
+#endif
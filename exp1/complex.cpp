@@ -0,0 +1,87 @@
+// complex.cpp
+#include "complex.h"
+#include "../common/datagen.h"
+using namespace std;
+
+namespace ds2025::exp1 {
+
+bool cmpByModulus(const Complex& a, const Complex& b) {
+    double ma = a.modulus(), mb = b.modulus();
+    if (fabs(ma - mb) < 1e-9) return a.real < b.real;
+    return ma < mb;
+}
+
+vector<Complex> generateRandomComplexVector(int n, int vmax, uint64_t seed) {
+    vector<Complex> v(n);
+    datagen::CounterRng rng(seed);
+    datagen::parallelFill(v.size(), datagen::defaultThreads(), [&](size_t i) {
+        datagen::complexAt(rng, i, vmax, v[i].real, v[i].imag);
+    });
+    return v;
+}
+
+vector<Complex> rangeQueryByModulus(const vector<Complex>& sortedVec, double m1, double m2) {
+    vector<Complex> res;
+    for (const auto& c : sortedVec) {
+        double m = c.modulus();
+        if (m >= m1 && m < m2) res.push_back(c);
+        if (m >= m2) break;
+    }
+    return res;
+}
+
+vector<Complex> parallelDedup(const vector<Complex>& v, unsigned threads, double eps) {
+    threads = max(threads, 1u);
+    size_t n = v.size(), chunk = (n + threads - 1) / threads;
+    size_t parts = max<size_t>(threads, min<size_t>(4096, n / 32768 + 1));
+    ComplexHashSet keys(eps);
+    auto parallel = [&](auto fn) {
+        vector<thread> ts;
+        for (unsigned t = 1; t < threads; ++t) ts.emplace_back(fn, t);
+        fn(0u);
+        for (auto& th : ts) th.join();
+    };
+
+    vector<uint64_t> hashes(n);
+    vector<vector<size_t>> cursor(threads, vector<size_t>(parts, 0));
+    parallel([&](unsigned t) {
+        for (size_t i = t * chunk; i < min(n, (t + 1) * chunk); ++i) {
+            hashes[i] = ComplexHashSet::hashKey(keys.key(v[i]));
+            ++cursor[t][(hashes[i] >> 40) % parts];
+        }
+    });
+    vector<size_t> partBegin(parts + 1, 0);
+    for (size_t p = 0, off = 0; p < parts; ++p) {
+        partBegin[p] = off;
+        for (unsigned t = 0; t < threads; ++t) { size_t c = cursor[t][p]; cursor[t][p] = off; off += c; }
+        partBegin[p + 1] = off;
+    }
+    vector<Complex> scattered(n);
+    vector<uint64_t> scatteredHash(n);
+    parallel([&](unsigned t) {
+        for (size_t i = t * chunk; i < min(n, (t + 1) * chunk); ++i) {
+            size_t pos = cursor[t][(hashes[i] >> 40) % parts]++;
+            scattered[pos] = v[i];
+            scatteredHash[pos] = hashes[i];
+        }
+    });
+    vector<size_t> kept(parts);
+    atomic<size_t> nextPart{0};
+    parallel([&](unsigned) {
+        ComplexHashSet set(eps);
+        for (size_t p; (p = nextPart.fetch_add(1)) < parts; ) {
+            size_t b = partBegin[p], e = partBegin[p + 1], w = b;
+            set.clear();
+            for (size_t i = b; i < e; ++i)
+                if (set.insertHashed(set.key(scattered[i]), scatteredHash[i])) scattered[w++] = scattered[i];
+            kept[p] = w - b;
+        }
+    });
+    vector<Complex> out;
+    out.reserve(accumulate(kept.begin(), kept.end(), (size_t)0));
+    for (size_t p = 0; p < parts; ++p)
+        out.insert(out.end(), scattered.begin() + partBegin[p], scattered.begin() + partBegin[p] + kept[p]);
+    return out;
+}
+
+}  // namespace ds2025::exp1
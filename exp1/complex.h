@@ -0,0 +1,608 @@
+// complex.h - complex numbers, sorting, modulus/spatial indexes and hashing (exp1 part 1)
+#ifndef COMPLEX_H
+#define COMPLEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace ds2025::exp1 {
+
+class Complex {
+public:
+    double real, imag;
+    Complex(double r = 0, double i = 0) : real(r), imag(i) {}
+    double modulus() const { return std::sqrt(real*real + imag*imag); }
+    bool operator==(const Complex& other) const {
+        return real == other.real && imag == other.imag;
+    }
+};
+
+bool cmpByModulus(const Complex& a, const Complex& b);
+
+// ---------- Sorting ----------
+// Every sort is templated on the comparator so lambdas and function objects are inlined.
+template <typename T, typename Cmp>
+void bubbleSort(std::vector<T>& v, Cmp cmp) {
+    size_t n = v.size();
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j + 1 < n - i; ++j)
+            if (cmp(v[j+1], v[j])) std::swap(v[j], v[j+1]);
+}
+
+template <typename It, typename Cmp>
+void insertionSort(It first, It last, Cmp cmp) {
+    if (first == last) return;
+    for (It i = first + 1; i != last; ++i) {
+        auto x = std::move(*i);
+        It j = i;
+        for (; j != first && cmp(x, *(j - 1)); --j) *j = std::move(*(j - 1));
+        *j = std::move(x);
+    }
+}
+
+// Insertion sort that gives up after `limit` element moves; true if the range ended sorted
+template <typename It, typename Cmp>
+bool partialInsertionSort(It first, It last, Cmp cmp, size_t limit = 8) {
+    if (first == last) return true;
+    size_t moves = 0;
+    for (It i = first + 1; i != last; ++i) {
+        if (!cmp(*i, *(i - 1))) continue;
+        auto x = std::move(*i);
+        It j = i;
+        for (; j != first && cmp(x, *(j - 1)); --j) *j = std::move(*(j - 1));
+        *j = std::move(x);
+        moves += i - j;
+        if (moves > limit) return false;
+    }
+    return true;
+}
+
+template <typename It, typename Cmp>
+void sort3(It a, It b, It c, Cmp cmp) {
+    if (cmp(*b, *a)) std::iter_swap(a, b);
+    if (cmp(*c, *b)) std::iter_swap(b, c);
+    if (cmp(*b, *a)) std::iter_swap(a, b);
+}
+
+// Pattern-defeating introsort: median-of-3 (ninther above 128 elements), insertion sort
+// below 24, a partial insertion sort when a partition needed no swaps (sorted input is
+// linear), element shuffles after unbalanced partitions and heapsort once too many occur.
+template <typename It, typename Cmp>
+void pdqLoop(It first, It last, Cmp cmp, int badAllowed, bool leftmost) {
+    const ptrdiff_t kInsertion = 24, kNinther = 128;
+    for (;;) {
+        ptrdiff_t n = last - first;
+        if (n < kInsertion) { insertionSort(first, last, cmp); return; }
+
+        ptrdiff_t h = n / 2;
+        if (n > kNinther) {
+            sort3(first, first + h, last - 1, cmp);
+            sort3(first + 1, first + (h - 1), last - 2, cmp);
+            sort3(first + 2, first + (h + 1), last - 3, cmp);
+            sort3(first + (h - 1), first + h, first + (h + 1), cmp);
+            std::iter_swap(first, first + h);
+        } else {
+            sort3(first + h, first, last - 1, cmp);
+        }
+
+        // an element equal to the pivot on our left means the range is all >= pivot:
+        // put the equal ones first and continue with the rest
+        if (!leftmost && !cmp(*(first - 1), *first)) {
+            It mid = std::partition(first + 1, last, [&](const auto& x) { return !cmp(*first, x); });
+            first = mid;
+            continue;
+        }
+
+        // partition around *first; elements equal to the pivot go right
+        auto pivot = std::move(*first);
+        It i = first, j = last;
+        while (cmp(*++i, pivot)) {}
+        if (i - 1 == first) { while (i < j && !cmp(*--j, pivot)) {} }
+        else { while (!cmp(*--j, pivot)) {} }
+        bool alreadyPartitioned = i >= j;
+        while (i < j) {
+            std::iter_swap(i, j);
+            while (cmp(*++i, pivot)) {}
+            while (!cmp(*--j, pivot)) {}
+        }
+        It p = i - 1;
+        *first = std::move(*p);
+        *p = std::move(pivot);
+
+        ptrdiff_t ls = p - first, rs = last - (p + 1);
+        if (ls < n / 8 || rs < n / 8) {
+            if (--badAllowed == 0) { std::make_heap(first, last, cmp); std::sort_heap(first, last, cmp); return; }
+            if (ls >= kInsertion) {
+                std::iter_swap(first, first + ls / 4);
+                std::iter_swap(p - 1, p - ls / 4);
+            }
+            if (rs >= kInsertion) {
+                std::iter_swap(p + 1, p + 1 + rs / 4);
+                std::iter_swap(last - 1, last - rs / 4);
+            }
+        } else if (alreadyPartitioned &&
+                   partialInsertionSort(first, p, cmp) && partialInsertionSort(p + 1, last, cmp)) {
+            return;
+        }
+        pdqLoop(first, p, cmp, badAllowed, leftmost);
+        first = p + 1;
+        leftmost = false;
+    }
+}
+
+template <typename It, typename Cmp>
+void introSort(It first, It last, Cmp cmp) {
+    ptrdiff_t n = last - first;
+    int logN = 0;
+    while (n > 1) { n >>= 1; ++logN; }
+    pdqLoop(first, last, cmp, logN + 1, true);
+}
+
+template <typename T, typename Cmp>
+void introSort(std::vector<T>& v, Cmp cmp) { introSort(v.begin(), v.end(), cmp); }
+
+// Bottom-up merge sort: 32-element runs are insertion sorted in place, then each pass
+// merges from one buffer into the other, so there is no copy-back after a merge and at
+// most one final copy when the result ends up in the scratch buffer.
+template <typename T, typename Cmp>
+void mergeSort(std::vector<T>& v, Cmp cmp) {
+    const size_t kRun = 32;
+    size_t n = v.size();
+    for (size_t b = 0; b < n; b += kRun) insertionSort(v.begin() + b, v.begin() + std::min(n, b + kRun), cmp);
+    if (n <= kRun) return;
+    std::vector<T> tmp(n);
+    T* src = v.data();
+    T* dst = tmp.data();
+    for (size_t width = kRun; width < n; width *= 2) {
+        for (size_t l = 0; l < n; l += 2 * width) {
+            size_t m = std::min(n, l + width), r = std::min(n, l + 2 * width);
+            size_t i = l, j = m, k = l;
+            while (i < m && j < r) dst[k++] = cmp(src[j], src[i]) ? src[j++] : src[i++];
+            while (i < m) dst[k++] = src[i++];
+            while (j < r) dst[k++] = src[j++];
+        }
+        std::swap(src, dst);
+    }
+    if (src != v.data()) std::copy(src, src + n, v.data());
+}
+
+// Decorate-sort-undecorate: key(x) is computed once per element instead of twice per
+// comparison; keys are compared with operator<
+template <typename T, typename KeyFn>
+void sortByKey(std::vector<T>& v, KeyFn key) {
+    using K = decltype(key(v[0]));
+    std::vector<std::pair<K, T>> dec;
+    dec.reserve(v.size());
+    for (auto& x : v) dec.emplace_back(key(x), std::move(x));
+    introSort(dec.begin(), dec.end(), [](const std::pair<K, T>& a, const std::pair<K, T>& b) { return a.first < b.first; });
+    for (size_t i = 0; i < v.size(); ++i) v[i] = std::move(dec[i].second);
+}
+
+// (|c|^2, real): the same order as cmpByModulus apart from its 1e-9 tolerance on ties
+inline std::pair<double, double> modulusKey(const Complex& c) { return {c.real*c.real + c.imag*c.imag, c.real}; }
+
+// Parts uniform on the 0.01 grid in [0, vmax); the same seed always gives the same vector
+std::vector<Complex> generateRandomComplexVector(int n, int vmax = 10, uint64_t seed = 2025);
+
+// elements of a vector sorted by cmpByModulus whose modulus lies in [m1, m2)
+std::vector<Complex> rangeQueryByModulus(const std::vector<Complex>& sortedVec, double m1, double m2);
+
+// Points ordered by squared modulus, with the squared moduli cached in a contiguous
+// array: range queries are two binary searches on m^2 and never call sqrt.
+class ComplexIndex {
+public:
+    // [begin, end) positions into points()
+    struct Span {
+        size_t begin, end;
+        size_t size() const { return end - begin; }
+    };
+
+    // Points with a NaN or infinite part have no place in the modulus order (a NaN key
+    // would break the sort and every search after it), so they are left out of the index.
+    explicit ComplexIndex(std::vector<Complex> v) : pts(std::move(v)) {
+        std::vector<std::pair<double, size_t>> keyed;
+        keyed.reserve(pts.size());
+        for (size_t i = 0; i < pts.size(); ++i)
+            if (std::isfinite(pts[i].real) && std::isfinite(pts[i].imag)) keyed.push_back({norm2(pts[i]), i});
+        dropped_ = pts.size() - keyed.size();
+        std::sort(keyed.begin(), keyed.end());
+        std::vector<Complex> sorted(keyed.size());
+        n2.resize(keyed.size());
+        for (size_t i = 0; i < keyed.size(); ++i) { sorted[i] = pts[keyed[i].second]; n2[i] = keyed[i].first; }
+        pts.swap(sorted);
+    }
+
+    // points with modulus in [m1, m2)
+    Span rangeQuery(double m1, double m2) const { return rangeFrom(0, m1, m2); }
+
+    // answers every [first, second) range in one merged sweep: the 2q bounds are sorted and
+    // a single cursor walks forward through n2, galloping from each bound to the next
+    std::vector<Span> rangeQueries(const std::vector<std::pair<double, double>>& ranges) const {
+        struct Bound { double key; size_t q; bool upper; };
+        std::vector<Bound> bounds;
+        bounds.reserve(2 * ranges.size());
+        for (size_t q = 0; q < ranges.size(); ++q) {
+            if (!(ranges[q].first < ranges[q].second)) continue;  // empty or NaN: stays {0, 0}
+            bounds.push_back({sq(ranges[q].first), q, false});
+            bounds.push_back({sq(ranges[q].second), q, true});
+        }
+        std::sort(bounds.begin(), bounds.end(), [](const Bound& a, const Bound& b) { return a.key < b.key; });
+        std::vector<Span> res(ranges.size(), Span{0, 0});
+        size_t pos = 0;
+        for (const Bound& b : bounds) {
+            pos = gallop(pos, b.key);
+            if (b.upper) res[b.q].end = pos;
+            else res[b.q].begin = pos;
+        }
+        return res;
+    }
+
+    const std::vector<Complex>& points() const { return pts; }
+    const Complex& operator[](size_t i) const { return pts[i]; }
+    size_t size() const { return pts.size(); }
+    // input points left out for a non-finite part
+    size_t dropped() const { return dropped_; }
+
+private:
+    std::vector<Complex> pts;
+    std::vector<double> n2;
+    size_t dropped_ = 0;
+
+    static double norm2(const Complex& c) { return c.real*c.real + c.imag*c.imag; }
+    static double sq(double m) { return m <= 0 ? 0 : m*m; }  // moduli are never negative
+
+    // first position >= from whose squared modulus is >= key, given n2[from-1] < key:
+    // doubling steps bracket it, then a binary search inside the last step
+    size_t gallop(size_t from, double key) const {
+        size_t lo = from, step = 1;
+        while (lo + step <= n2.size() && n2[lo + step - 1] < key) { lo += step; step *= 2; }
+        return std::lower_bound(n2.begin() + lo, n2.begin() + std::min(lo + step, n2.size()), key) - n2.begin();
+    }
+
+    Span rangeFrom(size_t from, double m1, double m2) const {
+        if (!(m1 < m2)) return {from, from};
+        size_t lo = std::lower_bound(n2.begin() + from, n2.end(), sq(m1)) - n2.begin();
+        size_t hi = std::lower_bound(n2.begin() + lo, n2.end(), sq(m2)) - n2.begin();
+        return {lo, hi};
+    }
+};
+
+// Implicit k-d tree over points in the complex plane, stored in Eytzinger (BFS) order:
+// node i has children 2i+1 and 2i+2, so the top levels that every query visits share a
+// few cache lines and there are no child pointers. Splits alternate real (even depth)
+// and imag (odd depth), each on the median of its subtree.
+class ComplexKdTree {
+public:
+    explicit ComplexKdTree(const std::vector<Complex>& v, unsigned threads = 1) : nodes(v.size()) {
+        std::vector<Node> pts(v.size());
+        for (size_t i = 0; i < v.size(); ++i) pts[i] = {v[i].real, v[i].imag, i};
+        int spawnDepth = 0;
+        while ((1u << spawnDepth) < std::max(threads, 1u)) ++spawnDepth;
+        build(pts, 0, pts.size(), 0, 0, spawnDepth);
+    }
+
+    // original indices of the k nearest points to q, nearest first
+    std::vector<size_t> nearest(const Complex& q, size_t k) const {
+        std::vector<std::pair<double, size_t>> heap;  // max-heap on squared distance
+        if (k > 0) knn(0, 0, q.real, q.imag, k, heap);
+        std::sort_heap(heap.begin(), heap.end());
+        std::vector<size_t> res;
+        for (auto& h : heap) res.push_back(h.second);
+        return res;
+    }
+
+    // points with x1 <= real <= x2 and y1 <= imag <= y2
+    std::vector<size_t> rectQuery(double x1, double y1, double x2, double y2) const {
+        std::vector<size_t> res;
+        double lo[2] = {x1, y1}, hi[2] = {x2, y2};
+        rect(0, 0, lo, hi, res);
+        return res;
+    }
+
+    // points with modulus in [r1, r2) and argument in the sector turning counterclockwise
+    // from angle a1 to a2 (radians; a2 - a1 >= 2*pi means the full annulus)
+    std::vector<size_t> annulusQuery(double r1, double r2, double a1, double a2) const {
+        Annulus q{r1 * r1, r2 * r2, normAngle(a1), a2 - a1 >= 2 * M_PI ? 2 * M_PI : normAngle(a2 - a1)};
+        std::vector<size_t> res;
+        Box box{{-HUGE_VAL, -HUGE_VAL}, {HUGE_VAL, HUGE_VAL}};
+        annulus(0, 0, box, q, res);
+        return res;
+    }
+
+    size_t size() const { return nodes.size(); }
+
+private:
+    struct Node { double c[2]; size_t id; };
+    struct Box { double lo[2], hi[2]; };
+    struct Annulus { double r1sq, r2sq, from, width; };
+    std::vector<Node> nodes;
+
+    static double normAngle(double a) {
+        a = std::fmod(a, 2 * M_PI);
+        return a < 0 ? a + 2 * M_PI : a;
+    }
+
+    // size of the left subtree of a complete binary tree with s > 0 nodes
+    static size_t leftSize(size_t s) {
+        size_t half = 1;
+        while (4 * half - 1 <= s) half *= 2;  // 2*half - 1 nodes fill the complete levels
+        return half - 1 + std::min(s - (2 * half - 1), half);
+    }
+
+    // places pts[l, r) as the subtree rooted at node i; subtrees write disjoint nodes
+    void build(std::vector<Node>& pts, size_t l, size_t r, size_t i, int depth, int spawnDepth) {
+        if (l >= r) return;
+        size_t m = l + leftSize(r - l);
+        int d = depth & 1;
+        std::nth_element(pts.begin() + l, pts.begin() + m, pts.begin() + r,
+                    [d](const Node& a, const Node& b) { return a.c[d] < b.c[d]; });
+        nodes[i] = pts[m];
+        if (depth < spawnDepth) {
+            std::thread t([=, &pts] { build(pts, l, m, 2 * i + 1, depth + 1, spawnDepth); });
+            build(pts, m + 1, r, 2 * i + 2, depth + 1, spawnDepth);
+            t.join();
+        } else {
+            build(pts, l, m, 2 * i + 1, depth + 1, spawnDepth);
+            build(pts, m + 1, r, 2 * i + 2, depth + 1, spawnDepth);
+        }
+    }
+
+    void knn(size_t i, int depth, double qx, double qy, size_t k, std::vector<std::pair<double, size_t>>& heap) const {
+        if (i >= nodes.size()) return;
+        const Node& nd = nodes[i];
+        double dx = nd.c[0] - qx, dy = nd.c[1] - qy;
+        double dist = dx*dx + dy*dy;
+        if (heap.size() < k) { heap.push_back({dist, nd.id}); std::push_heap(heap.begin(), heap.end()); }
+        else if (dist < heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = {dist, nd.id};
+            std::push_heap(heap.begin(), heap.end());
+        }
+        int d = depth & 1;
+        double diff = (d == 0 ? qx : qy) - nd.c[d];
+        bool goLeft = diff < 0;
+        knn(goLeft ? 2 * i + 1 : 2 * i + 2, depth + 1, qx, qy, k, heap);
+        if (heap.size() < k || diff * diff < heap.front().first)
+            knn(goLeft ? 2 * i + 2 : 2 * i + 1, depth + 1, qx, qy, k, heap);
+    }
+
+    void rect(size_t i, int depth, const double* lo, const double* hi, std::vector<size_t>& res) const {
+        if (i >= nodes.size()) return;
+        const Node& nd = nodes[i];
+        if (nd.c[0] >= lo[0] && nd.c[0] <= hi[0] && nd.c[1] >= lo[1] && nd.c[1] <= hi[1]) res.push_back(nd.id);
+        int d = depth & 1;
+        if (lo[d] <= nd.c[d]) rect(2 * i + 1, depth + 1, lo, hi, res);
+        if (hi[d] >= nd.c[d]) rect(2 * i + 2, depth + 1, lo, hi, res);
+    }
+
+    bool inSector(double x, double y, const Annulus& q) const {
+        return q.width >= 2 * M_PI || normAngle(std::atan2(y, x) - q.from) <= q.width;
+    }
+
+    // conservative: false only if no point of the box can satisfy the query
+    bool boxMayHit(const Box& b, const Annulus& q) const {
+        double nx = std::max(b.lo[0], std::min(0.0, b.hi[0])), ny = std::max(b.lo[1], std::min(0.0, b.hi[1]));
+        if (nx*nx + ny*ny >= q.r2sq) return false;
+        double fx = std::max(std::fabs(b.lo[0]), std::fabs(b.hi[0])), fy = std::max(std::fabs(b.lo[1]), std::fabs(b.hi[1]));
+        if (fx*fx + fy*fy < q.r1sq) return false;
+        if (q.width >= 2 * M_PI || (nx == 0 && ny == 0)) return true;
+        // the box misses the origin, so its corners span an arc shorter than pi
+        double corners[4][2] = {{b.lo[0], b.lo[1]}, {b.hi[0], b.lo[1]}, {b.lo[0], b.hi[1]}, {b.hi[0], b.hi[1]}};
+        double base = std::atan2(corners[0][1], corners[0][0]), dmin = 0, dmax = 0;
+        for (int i = 1; i < 4; ++i) {
+            double dlt = normAngle(std::atan2(corners[i][1], corners[i][0]) - base);
+            if (dlt > M_PI) dlt -= 2 * M_PI;
+            dmin = std::min(dmin, dlt); dmax = std::max(dmax, dlt);
+        }
+        double start = normAngle(base + dmin);
+        return normAngle(start - q.from) <= q.width || normAngle(q.from - start) <= dmax - dmin;
+    }
+
+    void annulus(size_t i, int depth, Box box, const Annulus& q, std::vector<size_t>& res) const {
+        if (i >= nodes.size() || !boxMayHit(box, q)) return;
+        const Node& nd = nodes[i];
+        double n2 = nd.c[0]*nd.c[0] + nd.c[1]*nd.c[1];
+        if (n2 >= q.r1sq && n2 < q.r2sq && inSector(nd.c[0], nd.c[1], q)) res.push_back(nd.id);
+        int d = depth & 1;
+        Box left = box, right = box;
+        left.hi[d] = nd.c[d];
+        right.lo[d] = nd.c[d];
+        annulus(2 * i + 1, depth + 1, left, q, res);
+        annulus(2 * i + 2, depth + 1, right, q, res);
+    }
+};
+
+// ---------- Hashing ----------
+// Open-addressing set in the Swiss-table style: one control byte per slot (empty, deleted
+// or the low 7 hash bits), scanned 16 at a time. Keys compare by canonical bit pattern, so
+// -0.0 equals +0.0 and every NaN equals every other NaN (unlike Complex::operator==).
+// With eps > 0 each part is quantized to round(x / eps) first, so values in the same
+// eps-wide cell collide on purpose (neighbours across a cell boundary stay distinct).
+// NaN, infinities and parts too large for a cell index keep their canonical bits instead,
+// tagged so they never collide with a cell.
+// Slots hold the 16-byte keys, so probing never recomputes a key.
+class ComplexHashSet {
+public:
+    explicit ComplexHashSet(double eps = 0, size_t expected = 0) : eps(eps) {
+        size_t cap = kGroup;
+        while (cap * 7 / 8 < expected) cap *= 2;
+        allocate(cap);
+    }
+
+    struct Key {
+        uint64_t a, b;
+        bool operator==(const Key& o) const { return a == o.a && b == o.b; }
+    };
+
+    Key key(const Complex& c) const {
+        if (eps > 0) return {cellBits(c.real), cellBits(c.imag)};
+        return {canonicalBits(c.real), canonicalBits(c.imag)};
+    }
+
+    static uint64_t hashKey(const Key& k) { return mix(k.a ^ mix(k.b + 0x9e3779b97f4a7c15ULL)); }
+
+    // true if c was not present yet
+    bool insert(const Complex& c) { Key k = key(c); return insertHashed(k, hashKey(k)); }
+    bool insertHashed(const Key& k, uint64_t h) {
+        if (find(k, h) != npos) return false;
+        if ((used + 1) > capacity() * 7 / 8) rehash(size_ * 2 >= capacity() * 7 / 8 ? capacity() * 2 : capacity());
+        size_t pos = freeSlot(h);
+        if (ctrl[pos] == kEmpty) ++used;
+        ctrl[pos] = h2(h);
+        slots[pos] = k;
+        ++size_;
+        return true;
+    }
+
+    bool contains(const Complex& c) const { Key k = key(c); return find(k, hashKey(k)) != npos; }
+
+    bool erase(const Complex& c) {
+        Key k = key(c);
+        size_t pos = find(k, hashKey(k));
+        if (pos == npos) return false;
+        ctrl[pos] = kDeleted;  // keeps probe chains through this slot intact
+        --size_;
+        return true;
+    }
+
+    // empties the set but keeps its capacity
+    void clear() {
+        std::fill(ctrl.begin(), ctrl.end(), kEmpty);
+        size_ = used = 0;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots.size(); }
+
+    // visits one representative per key: the canonical value, or the cell centre with eps > 0
+    template <typename F> void forEach(F f) const {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (ctrl[i] & 0x80) continue;
+            if (eps > 0) f(Complex(cellCentre(slots[i].a), cellCentre(slots[i].b)));
+            else f(Complex(fromBits(slots[i].a), fromBits(slots[i].b)));
+        }
+    }
+
+private:
+    static constexpr size_t kGroup = 16;
+    static constexpr uint8_t kEmpty = 0x80, kDeleted = 0xFE;
+    static constexpr size_t npos = SIZE_MAX;
+    double eps;
+    std::vector<uint8_t> ctrl;
+    std::vector<Key> slots;
+    size_t size_ = 0, used = 0;  // used counts live + deleted slots
+
+    static uint64_t canonicalBits(double x) {
+        if (x != x) return 0x7ff8000000000000ULL;  // all NaNs alike
+        x += 0.0;                                   // -0.0 -> +0.0
+        uint64_t b;
+        std::memcpy(&b, &x, sizeof b);
+        return b;
+    }
+    // Cell indices lie in (-2^62, 2^62), so their top two bits are 00 or 11; everything
+    // else gets the 01 tag over its canonical bits shifted right by two. NaN and the
+    // infinities keep distinct codes; finite values that far out lose their two lowest
+    // mantissa bits (adjacent doubles there are already 2^10 or more cells apart).
+    static constexpr uint64_t kOffGrid = 1ULL << 62;
+    uint64_t cellBits(double x) const {
+        double q = std::round(x / eps);
+        if (std::fabs(q) < 0x1p62) return (uint64_t)(int64_t)q;
+        return kOffGrid | canonicalBits(x) >> 2;
+    }
+    double cellCentre(uint64_t a) const {
+        if (a >> 62 == 1) return fromBits(a << 2);
+        return (int64_t)a * eps;
+    }
+    static double fromBits(uint64_t b) {
+        double x;
+        std::memcpy(&x, &b, sizeof x);
+        return x;
+    }
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+    static uint8_t h2(uint64_t h) { return h & 0x7F; }
+    size_t groupMask() const { return slots.size() / kGroup - 1; }
+
+    // bit i set when ctrl[g*16 + i] == b
+    uint32_t matchByte(size_t g, uint8_t b) const {
+#ifdef __SSE2__
+        __m128i c = _mm_loadu_si128((const __m128i*)&ctrl[g * kGroup]);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8((char)b)));
+#else
+        uint32_t m = 0;
+        for (size_t i = 0; i < kGroup; ++i) if (ctrl[g * kGroup + i] == b) m |= 1u << i;
+        return m;
+#endif
+    }
+    uint32_t matchFree(size_t g) const {  // empty or deleted: high bit set
+#ifdef __SSE2__
+        return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)&ctrl[g * kGroup]));
+#else
+        uint32_t m = 0;
+        for (size_t i = 0; i < kGroup; ++i) if (ctrl[g * kGroup + i] & 0x80) m |= 1u << i;
+        return m;
+#endif
+    }
+
+    // groups are probed triangularly, which visits every group of a power-of-two table
+    size_t find(const Key& k, uint64_t h) const {
+        size_t g = (h >> 7) & groupMask();
+        for (size_t step = 1; ; ++step) {
+            for (uint32_t m = matchByte(g, h2(h)); m; m &= m - 1) {
+                size_t pos = g * kGroup + __builtin_ctz(m);
+                if (slots[pos] == k) return pos;
+            }
+            if (matchByte(g, kEmpty)) return npos;
+            g = (g + step) & groupMask();
+        }
+    }
+    size_t freeSlot(uint64_t h) const {
+        size_t g = (h >> 7) & groupMask();
+        for (size_t step = 1; ; ++step) {
+            if (uint32_t m = matchFree(g)) return g * kGroup + __builtin_ctz(m);
+            g = (g + step) & groupMask();
+        }
+    }
+
+    void allocate(size_t cap) {
+        ctrl.assign(cap, kEmpty);
+        slots.assign(cap, Key{0, 0});
+        size_ = used = 0;
+    }
+    void rehash(size_t cap) {
+        std::vector<uint8_t> oldCtrl; std::vector<Key> oldSlots;
+        oldCtrl.swap(ctrl); oldSlots.swap(slots);
+        allocate(cap);
+        for (size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldCtrl[i] & 0x80) continue;
+            uint64_t h = hashKey(oldSlots[i]);
+            size_t pos = freeSlot(h);
+            ctrl[pos] = h2(h); slots[pos] = oldSlots[i];
+            ++size_; ++used;
+        }
+    }
+};
+
+// Hash-partitioned dedup in O(n) expected time. Hashes are computed once and elements are
+// scattered by hash into partitions of roughly 32K elements, so each partition's table stays
+// cache- and TLB-resident; threads then deduplicate whole partitions independently and
+// compact them in place. Output order is partition by partition, not input order.
+std::vector<Complex> parallelDedup(const std::vector<Complex>& v, unsigned threads, double eps = 0);
+
+}  // namespace ds2025::exp1
+
+#endif
@@ -1,71 +1,13 @@
 // exp1_part1_complex.cpp
-#include <bits/stdc++.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "complex.h"
 using namespace std;
-
-class Complex {
-public:
-    double real, imag;
-    Complex(double r = 0, double i = 0) : real(r), imag(i) {}
-    double modulus() const { return sqrt(real*real + imag*imag); }
-    bool operator==(const Complex& other) const {
-        return real == other.real && imag == other.imag;
-    }
-};
-
-bool cmpByModulus(const Complex& a, const Complex& b) {
-    double ma = a.modulus(), mb = b.modulus();
-    if (fabs(ma - mb) < 1e-9) return a.real < b.real;
-    return ma < mb;
-}
-
-void bubbleSort(vector<Complex>& v, bool (*cmp)(const Complex&, const Complex&)) {
-    size_t n = v.size();
-    for (size_t i = 0; i < n; ++i)
-        for (size_t j = 0; j + 1 < n - i; ++j)
-            if (!cmp(v[j], v[j+1])) swap(v[j], v[j+1]);
-}
-
-void mergeSortImpl(vector<Complex>& v, vector<Complex>& tmp, int l, int r, bool (*cmp)(const Complex&, const Complex&)) {
-    if (r - l <= 1) return;
-    int m = (l + r) / 2;
-    mergeSortImpl(v, tmp, l, m, cmp);
-    mergeSortImpl(v, tmp, m, r, cmp);
-    int i = l, j = m, k = l;
-    while (i < m || j < r) {
-        if (j >= r || (i < m && cmp(v[i], v[j]))) tmp[k++] = v[i++];
-        else tmp[k++] = v[j++];
-    }
-    for (int t = l; t < r; ++t) v[t] = tmp[t];
-}
-
-void mergeSort(vector<Complex>& v, bool (*cmp)(const Complex&, const Complex&)) {
-    vector<Complex> tmp(v.size());
-    mergeSortImpl(v, tmp, 0, (int)v.size(), cmp);
-}
-
-vector<Complex> generateRandomComplexVector(int n, int vmax=10) {
-    vector<Complex> v;
-    random_device rd; mt19937 gen(rd());
-    uniform_real_distribution<> dis(0, vmax);
-    for (int i = 0; i < n; ++i) {
-        double r = round(dis(gen) * 100.0) / 100.0;
-        double im = round(dis(gen) * 100.0) / 100.0;
-        v.emplace_back(r, im);
-    }
-    return v;
-}
-
-vector<Complex> rangeQueryByModulus(const vector<Complex>& sortedVec, double m1, double m2) {
-    vector<Complex> res;
-    for (const auto& c : sortedVec) {
-        double m = c.modulus();
-        if (m >= m1 && m < m2) res.push_back(c);
-        if (m >= m2) break;
-    }
-    return res;
-}
+using namespace ds2025::exp1;
 
 int main() {
+    bool ok = true;
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
 
@@ -75,26 +17,35 @@ int main() {
     cout << "\n\n";
 
     auto v_shuf = vec;
-    shuffle(v_shuf.begin(), v_shuf.end(), mt19937(chrono::steady_clock::now().time_since_epoch().count()));
+    shuffle(v_shuf.begin(), v_shuf.end(), mt19937(2025));
     cout << "Shuffled:\n";
     for (auto &c : v_shuf) cout << "("<<c.real<<","<<c.imag<<") ";
     cout << "\n\n";
 
     Complex target = v_shuf[3];
-    auto it = find_if(v_shuf.begin(), v_shuf.end(), [&](const Complex& x){ return x == target; });
-    cout << "Searching for ("<<target.real<<","<<target.imag<<") => " << (it!=v_shuf.end() ? "Found\n" : "Not Found\n");
+    ComplexHashSet members(0, v_shuf.size());
+    for (auto& c : v_shuf) members.insert(c);
+    cout << "Searching for ("<<target.real<<","<<target.imag<<") => " << (members.contains(target) ? "Found\n" : "Not Found\n");
 
     v_shuf.push_back(Complex(5.5, 5.5));
     cout << "After inserting (5.5,5.5), size = " << v_shuf.size() << "\n";
     v_shuf.erase(remove_if(v_shuf.begin(), v_shuf.end(), [](const Complex& x){ return fabs(x.real-5.5)<1e-9 && fabs(x.imag-5.5)<1e-9; }), v_shuf.end());
     cout << "After removing (5.5,5.5), size = " << v_shuf.size() << "\n";
 
-    sort(v_shuf.begin(), v_shuf.end(), [](const Complex& a, const Complex& b){
-        if (a.real != b.real) return a.real < b.real;
-        return a.imag < b.imag;
-    });
-    v_shuf.erase(unique(v_shuf.begin(), v_shuf.end(), [](const Complex& a, const Complex& b){ return a==b; }), v_shuf.end());
-    cout << "After unique, size = " << v_shuf.size() << "\n\n";
+    // unique: keep the first occurrence of each value, in order
+    ComplexHashSet seen(0, v_shuf.size());
+    v_shuf.erase(remove_if(v_shuf.begin(), v_shuf.end(), [&](const Complex& x){ return !seen.insert(x); }), v_shuf.end());
+    cout << "After unique, size = " << v_shuf.size() << "\n";
+    ok &= v_shuf.size() == members.size();
+    cout << "Hash set: " << members.size() << " distinct, contains (-0.0," << target.imag << ") same as (0.0,"
+         << target.imag << "): " << (members.contains(Complex(-0.0, target.imag)) == members.contains(Complex(0.0, target.imag)))
+         << "\n";
+    // with eps > 0, non-finite and huge parts stay apart from each other and from every cell
+    ComplexHashSet cells(0.5);
+    for (double x : {(double)NAN, (double)INFINITY, -(double)INFINITY, 1e300, -1e300, 0.0}) cells.insert(Complex(x, 0));
+    bool offGrid = cells.size() == 6 && cells.contains(Complex(NAN, 0)) && !cells.contains(Complex(1.0, 0));
+    ok &= offGrid;
+    cout << "eps=0.5 set keeps NaN, +-inf and +-1e300 apart: " << offGrid << "\n\n";
 
     vector<Complex> seq = v_shuf;
     sort(seq.begin(), seq.end(), cmpByModulus); 
@@ -103,26 +54,41 @@ int main() {
     vector<Complex> desc = seq; reverse(desc.begin(), desc.end());
     vector<Complex> rnd = seq; shuffle(rnd.begin(), rnd.end(), mt19937(12345));
 
-    auto time_bubble = [&](vector<Complex> a){
+    auto byModulus = [](const Complex& a, const Complex& b) { return cmpByModulus(a, b); };
+    auto time_sort = [&](vector<Complex> a, int which){
         auto t0 = chrono::high_resolution_clock::now();
-        bubbleSort(a, cmpByModulus);
+        if (which == 0) bubbleSort(a, byModulus);
+        else if (which == 1) mergeSort(a, byModulus);
+        else if (which == 2) introSort(a, byModulus);
+        else if (which == 3) sortByKey(a, modulusKey);
+        else sort(a.begin(), a.end(), byModulus);
         auto t1 = chrono::high_resolution_clock::now();
+        if (!is_sorted(a.begin(), a.end(), [](const Complex& x, const Complex& y){ return x.modulus() < y.modulus() - 1e-9; })) {
+            ok = false;
+            cout << "(unsorted!) ";
+        }
         return chrono::duration<double, milli>(t1 - t0).count();
     };
-    auto time_merge = [&](vector<Complex> a){
-        auto t0 = chrono::high_resolution_clock::now();
-        mergeSort(a, cmpByModulus);
-        auto t1 = chrono::high_resolution_clock::now();
-        return chrono::duration<double, milli>(t1 - t0).count();
+    const char* names[] = {"Bubble sort", "Merge sort", "Intro sort", "Sort by key", "std::sort"};
+    auto report = [&](const vector<Complex>& a, const vector<Complex>& r, const vector<Complex>& d, int from){
+        for (int w = from; w < 5; ++w) {
+            cout << names[w] << " on asc: " << time_sort(a, w) << " ms\n";
+            cout << names[w] << " on rnd: " << time_sort(r, w) << " ms\n";
+            cout << names[w] << " on desc: " << time_sort(d, w) << " ms\n";
+        }
+        cout << "\n";
     };
 
     cout << "Timing (ms):\n";
-    cout << "Bubble sort on asc: " << time_bubble(asc) << " ms\n";
-    cout << "Bubble sort on rnd: " << time_bubble(rnd) << " ms\n";
-    cout << "Bubble sort on desc: " << time_bubble(desc) << " ms\n";
-    cout << "Merge sort on asc: " << time_merge(asc) << " ms\n";
-    cout << "Merge sort on rnd: " << time_merge(rnd) << " ms\n";
-    cout << "Merge sort on desc: " << time_merge(desc) << " ms\n\n";
+    report(asc, rnd, desc, 0);
+
+    // the same three orders at a size where the O(n log n) sorts can be told apart
+    vector<Complex> bigAsc = generateRandomComplexVector(1000000, 1000);
+    sortByKey(bigAsc, modulusKey);
+    vector<Complex> bigDesc(bigAsc.rbegin(), bigAsc.rend());
+    vector<Complex> bigRnd = bigAsc; shuffle(bigRnd.begin(), bigRnd.end(), mt19937(12345));
+    cout << "Timing on 1000000 elements (ms):\n";
+    report(bigAsc, bigRnd, bigDesc, 1);
 
     sort(seq.begin(), seq.end(), cmpByModulus);
     double m1 = 5.0, m2 = 12.0;
@@ -131,5 +97,101 @@ int main() {
     for (auto &c: res) cout << "("<<c.real<<","<<c.imag<<") mod="<<c.modulus()<<" ";
     cout << "\n\n";
 
-    return 0;
+    ComplexIndex small(seq);
+    auto span = small.rangeQuery(m1, m2);
+    ok &= span.size() == res.size();
+    cout << "ComplexIndex range query in ["<<m1<<","<<m2<<") found " << span.size() << " items"
+         << (span.size() == res.size() ? "" : "  MISMATCH") << "\n";
+
+    // non-finite points are left out instead of corrupting the order
+    vector<Complex> tainted = seq;
+    tainted.insert(tainted.begin() + tainted.size() / 2, {Complex(NAN, 1), Complex(2, INFINITY), Complex(-INFINITY, NAN)});
+    ComplexIndex guarded(tainted);
+    bool sameSpan = guarded.rangeQuery(m1, m2).size() == res.size() && guarded.dropped() == 3;
+    ok &= sameSpan;
+    cout << "with 3 non-finite points: " << guarded.dropped() << " dropped, range query found "
+         << guarded.rangeQuery(m1, m2).size() << " items" << (sameSpan ? "" : "  MISMATCH") << "\n\n";
+
+    // large set: linear scan over the sorted vector vs. index queries
+    auto big = generateRandomComplexVector(5000000, 1000);
+    auto t0 = chrono::high_resolution_clock::now();
+    ComplexIndex index(big);
+    auto t1 = chrono::high_resolution_clock::now();
+    sort(big.begin(), big.end(), cmpByModulus);
+    vector<pair<double, double>> ranges;
+    mt19937 qgen(7);
+    uniform_real_distribution<> qdis(0, 1400);
+    for (int q = 0; q < 20; ++q) { double a = qdis(qgen); ranges.push_back({a, a + 5}); }
+    auto t2 = chrono::high_resolution_clock::now();
+    vector<size_t> linear;
+    for (auto& r : ranges) linear.push_back(rangeQueryByModulus(big, r.first, r.second).size());
+    auto t3 = chrono::high_resolution_clock::now();
+    auto spans = index.rangeQueries(ranges);
+    auto t4 = chrono::high_resolution_clock::now();
+    size_t linearHits = 0, indexHits = 0;
+    bool sameHits = true;
+    for (size_t q = 0; q < ranges.size(); ++q) {
+        linearHits += linear[q];
+        indexHits += spans[q].size();
+        sameHits &= spans[q].size() == linear[q];
+    }
+    ok &= sameHits;
+    cout << "5M points, 20 range queries: linear " << linearHits << " hits in "
+         << chrono::duration<double, milli>(t3 - t2).count() << " ms, index " << indexHits << " hits in "
+         << chrono::duration<double, milli>(t4 - t3).count() << " ms (build "
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms)" << (sameHits ? "" : "  MISMATCH")
+         << "\n";
+
+    // spatial queries on the same 5M points, checked against brute force
+    t0 = chrono::high_resolution_clock::now();
+    ComplexKdTree tree(big, thread::hardware_concurrency());
+    t1 = chrono::high_resolution_clock::now();
+    cout << "\nk-d tree build on " << tree.size() << " points: " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+
+    Complex q(400, 300);
+    t0 = chrono::high_resolution_clock::now();
+    auto knn = tree.nearest(q, 10);
+    auto rectHits = tree.rectQuery(100, 100, 120, 140);
+    auto annHits = tree.annulusQuery(500, 510, M_PI / 6, M_PI / 3);
+    t1 = chrono::high_resolution_clock::now();
+    auto dist2 = [&](const Complex& c) { return (c.real-q.real)*(c.real-q.real) + (c.imag-q.imag)*(c.imag-q.imag); };
+    vector<double> d(big.size());
+    for (size_t i = 0; i < big.size(); ++i) d[i] = dist2(big[i]);
+    nth_element(d.begin(), d.begin() + 9, d.end());
+    size_t bruteRect = 0, bruteAnn = 0;
+    for (auto& c : big) {
+        if (c.real >= 100 && c.real <= 120 && c.imag >= 100 && c.imag <= 140) ++bruteRect;
+        double n2 = c.real*c.real + c.imag*c.imag, a = atan2(c.imag, c.real);
+        if (n2 >= 500.0*500 && n2 < 510.0*510 && a >= M_PI / 6 && a <= M_PI / 3) ++bruteAnn;
+    }
+    t2 = chrono::high_resolution_clock::now();
+    bool sameKnn = knn.size() == 10 && dist2(big[knn.back()]) == d[9];
+    bool sameRect = rectHits.size() == bruteRect, sameAnn = annHits.size() == bruteAnn;
+    ok &= sameKnn && sameRect && sameAnn;
+    cout << "10-NN of (400,300): farthest dist^2 " << dist2(big[knn.back()]) << " (brute " << d[9] << ")"
+         << (sameKnn ? "" : "  MISMATCH") << "\n";
+    cout << "rectangle hits " << rectHits.size() << " (brute " << bruteRect << "), annulus sector hits "
+         << annHits.size() << " (brute " << bruteAnn << ")" << (sameRect && sameAnn ? "" : "  MISMATCH") << "\n";
+    cout << "queries: tree " << chrono::duration<double, milli>(t1 - t0).count() << " ms, brute "
+         << chrono::duration<double, milli>(t2 - t1).count() << " ms\n";
+    // dedup of 10M values on a 0.01 grid: sort + unique vs. hash partitions
+    auto dupes = generateRandomComplexVector(10000000, 20);
+    t0 = chrono::high_resolution_clock::now();
+    auto sortedCopy = dupes;
+    sort(sortedCopy.begin(), sortedCopy.end(), [](const Complex& a, const Complex& b){
+        if (a.real != b.real) return a.real < b.real;
+        return a.imag < b.imag;
+    });
+    sortedCopy.erase(unique(sortedCopy.begin(), sortedCopy.end()), sortedCopy.end());
+    t1 = chrono::high_resolution_clock::now();
+    auto hashed = parallelDedup(dupes, thread::hardware_concurrency());
+    t2 = chrono::high_resolution_clock::now();
+    auto coarse = parallelDedup(dupes, thread::hardware_concurrency(), 0.5);
+    auto t3b = chrono::high_resolution_clock::now();
+    ok &= hashed.size() == sortedCopy.size();
+    cout << "\ndedup of " << dupes.size() << ": sort+unique " << sortedCopy.size() << " in "
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms, hash " << hashed.size() << " in "
+         << chrono::duration<double, milli>(t2 - t1).count() << " ms, eps=0.5 cells " << coarse.size() << " in "
+         << chrono::duration<double, milli>(t3b - t2).count() << " ms\n";
+    return ok ? 0 : 1;
 }
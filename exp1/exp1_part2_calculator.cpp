@@ -1,96 +1,25 @@
 // exp1_part2_calculator.cpp
-#include <bits/stdc++.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include "calculator.h"
+#include "../common/datagen.h"
 using namespace std;
-
-// Helper: determine if a char is operator
-bool isOp(char c) {
-    return c=='+' || c=='-' || c=='*' || c=='/' || c=='^';
-}
-
-int prec(char op) {
-    if (op=='+' || op=='-') return 1;
-    if (op=='*' || op=='/') return 2;
-    if (op=='^') return 3;
-    return 0;
-}
-
-// apply operator to two operands (double)
-double applyOp(double a, double b, char op) {
-    if (op=='+') return a + b;
-    if (op=='-') return a - b;
-    if (op=='*') return a * b;
-    if (op=='/') return a / b;
-    if (op=='^') return pow(a, b);
-    throw runtime_error("Unknown op");
-}
-
-// Evaluate infix expression using two stacks (supports parentheses and unary minus)
-double evaluate(const string& s) {
-    stack<double> values;
-    stack<char> ops;
-    int i = 0;
-    int n = (int)s.size();
-    while (i < n) {
-        if (isspace(s[i])) { ++i; continue; }
-        if (s[i]=='(') { ops.push(s[i]); ++i; }
-        else if (isdigit(s[i]) || s[i]=='.') {
-            // parse number
-            int j = i;
-            while (j < n && (isdigit(s[j]) || s[j]=='.')) ++j;
-            double val = stod(s.substr(i, j-i));
-            values.push(val);
-            i = j;
-        } else if (s[i]==')') {
-            while (!ops.empty() && ops.top()!='(') {
-                double b = values.top(); values.pop();
-                double a = values.top(); values.pop();
-                char op = ops.top(); ops.pop();
-                values.push(applyOp(a,b,op));
-            }
-            if (!ops.empty() && ops.top()=='(') ops.pop();
-            ++i;
-        } else if (isOp(s[i])) {
-            // handle unary minus
-            if (s[i]=='-' && (i==0 || s[i-1]=='(' || isOp(s[i-1]))) {
-                // unary minus: parse the number after it
-                int j = i+1;
-                bool negativeNumber = false;
-                if (s[j] == '(') { // treat as 0 - ( ... )
-                    values.push(0);
-                } else {
-                    while (j < n && (isdigit(s[j]) || s[j]=='.')) ++j;
-                }
-                // fall through to normal operator processing
-            }
-            while (!ops.empty() && prec(ops.top()) >= prec(s[i])) {
-                char op = ops.top(); ops.pop();
-                double b = values.top(); values.pop();
-                double a = values.top(); values.pop();
-                values.push(applyOp(a,b,op));
-            }
-            ops.push(s[i]);
-            ++i;
-        } else {
-            throw runtime_error(string("Invalid character: ") + s[i]);
-        }
-    }
-    while (!ops.empty()) {
-        char op = ops.top(); ops.pop();
-        double b = values.top(); values.pop();
-        double a = values.top(); values.pop();
-        values.push(applyOp(a,b,op));
-    }
-    if (values.empty()) throw runtime_error("Empty expression");
-    return values.top();
-}
+using namespace ds2025::exp1;
 
 int main() {
+    bool ok = true;
     vector<string> tests = {
         "3 + (2 * 2) - 5",
         "2^3 + 4*5",
         "10 / (2 + 3)",
         "-3 + 4 * 2",
-        "3.5 + 2.25 * (1.2 + 0.8)"
+        "3.5 + 2.25 * (1.2 + 0.8)",
+        "-(2 + 3) * 2",
+        "2 ^ -1",
+        "-2^2",
+        "3 - -2",
+        "(1 + 2"
     };
     for (auto &t : tests) {
         try {
@@ -99,5 +28,67 @@ int main() {
             cout << "Error evaluating: " << t << " : " << e.what() << "\n";
         }
     }
-    return 0;
+
+    // column evaluation vs. row-by-row scalar evaluation
+    const size_t N = 1 << 20;
+    ds2025::datagen::CounterRng rng(2025);
+    unordered_map<string, vector<double>> cols;
+    uint64_t draw = 0;
+    for (const char* name : {"x", "y", "z"}) {
+        auto& c = cols[name];
+        c.resize(N);
+        ds2025::datagen::parallelFill(N, ds2025::datagen::defaultThreads(), [&](size_t r) { c[r] = rng.uniform(r, draw, 0.5, 10); });
+        ++draw;
+    }
+    vector<string> colTests = {"x*2 + y^2 - -z", "-(x - y) / z + 1.5", "x ^ (y / 10) * z - x*y"};
+    cout << "\nColumn evaluation, N = " << N << ":\n";
+    for (auto& t : colTests) {
+        auto t0 = chrono::high_resolution_clock::now();
+        auto res = evaluateColumns(t, cols);
+        auto t1 = chrono::high_resolution_clock::now();
+        CompiledExpr e = compile(t);
+        vector<double> row(e.vars.size());
+        size_t mismatch = 0;
+        for (size_t r = 0; r < N; ++r) {
+            for (size_t v = 0; v < e.vars.size(); ++v) row[v] = cols[e.vars[v]][r];
+            double ref = evalCompiled(e, row.data());
+            if (fabs(ref - res[r]) > 1e-12 * max(1.0, fabs(ref))) ++mismatch;
+        }
+        ok &= mismatch == 0;
+        auto t2 = chrono::high_resolution_clock::now();
+        cout << t << " : column " << chrono::duration<double, milli>(t1 - t0).count() << " ms, scalar "
+             << chrono::duration<double, milli>(t2 - t1).count() << " ms, mismatches = " << mismatch << "\n";
+    }
+
+    // batch of repeated formulas (10% malformed): try/catch loop vs. cached parallel batch
+    vector<string> formulas = {"1 + 2 * 3", "(4 - 1) ^ 2 / 3", "-7.5 * (2 + -1)", "10 / (3 - 1) - 0.25"};
+    vector<string> bad = {"2 * (3 + ", "4 ++ ", "1.2.3 + 1"};
+    vector<string> batch(200000);
+    ds2025::datagen::CounterRng pick(7);
+    for (size_t i = 0; i < batch.size(); ++i)
+        batch[i] = (i % 10 == 9) ? bad[pick.below(i, 0, bad.size())]
+                                 : formulas[pick.below(i, 1, formulas.size())] + " + " + to_string(pick.below(i, 2, 500));
+    auto t0 = chrono::high_resolution_clock::now();
+    vector<double> serial(batch.size());
+    size_t serialErrors = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        try { serial[i] = evaluate(batch[i]); } catch (exception&) { ++serialErrors; serial[i] = 0; }
+    }
+    auto t1 = chrono::high_resolution_clock::now();
+    ThreadPool pool;
+    ParseCache cache;
+    auto results = evaluateBatch(batch, pool, cache);
+    auto t2 = chrono::high_resolution_clock::now();
+    size_t batchErrors = 0, diff = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (results[i].error) ++batchErrors;
+        else if (results[i].value != serial[i]) ++diff;
+    }
+    ok &= serialErrors == batchErrors && diff == 0;
+    cout << "\nBatch of " << batch.size() << " (" << pool.size() << " threads): serial "
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms, batch "
+         << chrono::duration<double, milli>(t2 - t1).count() << " ms\n";
+    cout << "errors serial/batch = " << serialErrors << "/" << batchErrors << ", value mismatches = " << diff
+         << ", cache hits/misses = " << cache.hitCount() << "/" << cache.missCount() << "\n";
+    return ok ? 0 : 1;
 }
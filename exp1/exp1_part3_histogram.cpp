@@ -1,25 +1,31 @@
 // exp1_part3_histogram.cpp
-#include <bits/stdc++.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include "histogram.h"
+#include "../common/datagen.h"
 using namespace std;
+using namespace ds2025::exp1;
 
-int largestRectangleArea(vector<int>& heights) {
-    stack<int> s;
-    int n = heights.size();
-    int maxA = 0;
-    for (int i = 0; i <= n; ++i) {
-        int h = (i==n ? 0 : heights[i]);
-        while (!s.empty() && h < heights[s.top()]) {
-            int height = heights[s.top()]; s.pop();
-            int left = s.empty() ? -1 : s.top();
-            int width = i - left - 1;
-            maxA = max(maxA, height * width);
-        }
-        s.push(i);
+// Usage: exp1_part3_histogram [file|-] [--binary] streams heights from a file or stdin
+int main(int argc, char** argv) {
+    bool ok = true;
+    if (argc > 1) {
+        FILE* f = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+        if (!f) { cerr << "cannot open " << argv[1] << "\n"; return 1; }
+        StreamingHistogram sh;
+        StreamingHistogram::FeedErrors err =
+            argc > 2 && strcmp(argv[2], "--binary") == 0 ? sh.feedBinary(f) : sh.feedText(f);
+        if (f != stdin) fclose(f);
+        cout << "bars = " << sh.size() << ", max area = " << sh.best() << ", stack depth = " << sh.depth() << "\n";
+        if (!err.ok())
+            cerr << "rejected input: " << err.negative << " negative, " << err.overflow << " overflowing, "
+                 << err.malformed << " malformed, " << err.trailingBytes << " trailing bytes of a partial record\n";
+        return err.ok() ? 0 : 1;
     }
-    return maxA;
-}
 
-int main() {
     vector<vector<int>> tests = {
         {2,1,5,6,2,3},
         {2,4},
@@ -28,19 +34,79 @@ int main() {
         {6,2,5,4,5,1,6}
     };
     for (auto &t : tests) {
-        auto copy = t;
         cout << "heights = [";
         for (int i=0;i<(int)t.size();++i){ if (i) cout << ","; cout << t[i]; }
-        cout << "] -> max area = " << largestRectangleArea(copy) << "\n";
+        cout << "] -> max area = " << largestRectangleArea(t) << "\n";
     }
     // random 10 group tests
     cout << "\nRandom 10 tests:\n";
-    random_device rd; mt19937 gen(rd()); uniform_int_distribution<> dis(0, 100);
+    ds2025::datagen::CounterRng lens(1);
     for (int k=0;k<10;++k) {
-        int len = 1 + (gen() % 100);
+        int len = 1 + (int)lens.below(k, 0, 100);
         vector<int> a(len);
-        for (int i=0;i<len;++i) a[i] = dis(gen);
+        ds2025::datagen::fillHeights(a.data(), len, 0, 100, 100 + k);
         cout << "test " << k+1 << " len=" << len << " -> " << largestRectangleArea(a) << "\n";
     }
-    return 0;
+
+    // 64-bit area: 100000 bars of height 100000 overflow int
+    vector<int> tall(100000, 100000);
+    cout << "\n100000 x 100000 -> " << largestRectangleArea(tall) << "\n";
+
+    // parallel vs. serial on a large histogram (random and sorted inputs)
+    size_t N = 20000000;
+    vector<int> big(N);
+    ds2025::datagen::fillHeights(big.data(), N, 0, 1000000, 2);
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) sort(big.begin(), big.end());
+        auto t0 = chrono::high_resolution_clock::now();
+        long long s = largestRectangleArea(big);
+        auto t1 = chrono::high_resolution_clock::now();
+        long long p = largestRectangleAreaParallel(big.data(), big.size(), 8);
+        auto t2 = chrono::high_resolution_clock::now();
+        ok &= s == p;
+        cout << (pass ? "sorted" : "random") << " N=" << N << ": serial " << s << " ("
+             << chrono::duration<double, milli>(t1 - t0).count() << " ms), parallel " << p << " ("
+             << chrono::duration<double, milli>(t2 - t1).count() << " ms)" << (s == p ? "" : "  MISMATCH") << "\n";
+    }
+
+    // 2-D maximal rectangle on a random matrix with a planted block of ones
+    BitMatrix mat(2000, 3000);
+    ds2025::datagen::CounterRng bit(3);
+    ds2025::datagen::parallelFill(mat.rows, ds2025::datagen::defaultThreads(), [&](size_t r) {  // rows own disjoint words
+        for (int c = 0; c < mat.cols; ++c)
+            if (bit.uniform((uint64_t)r * mat.cols + c) < 0.6 || (r >= 500 && r < 900 && c >= 1000 && c < 1700))
+                mat.set((int)r, c);
+    });
+    auto t0 = chrono::high_resolution_clock::now();
+    long long area = maximalRectangle(mat);
+    auto t1 = chrono::high_resolution_clock::now();
+    cout << "\nmaximal rectangle in 2000x3000 matrix = " << area << " ("
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms)\n";
+
+    // streaming vs. in-memory over a binary trace written to a temporary file
+    FILE* trace = tmpfile();
+    const size_t traceLen = 20000000;
+    vector<int> chunk(1 << 16);
+    ds2025::datagen::CounterRng traceRng(4);
+    for (size_t done = 0; done < traceLen; done += chunk.size()) {
+        for (size_t j = 0; j < chunk.size(); ++j) chunk[j] = (int)traceRng.range(done + j, 0, 0, 1 << 20);
+        fwrite(chunk.data(), sizeof(int), chunk.size(), trace);
+    }
+    size_t bytes = ftell(trace);
+    rewind(trace);
+    t0 = chrono::high_resolution_clock::now();
+    vector<int> all(bytes / sizeof(int));
+    if (fread(all.data(), sizeof(int), all.size(), trace) != all.size()) cerr << "short read\n";
+    long long inMemory = largestRectangleArea(all);
+    t1 = chrono::high_resolution_clock::now();
+    rewind(trace);
+    StreamingHistogram sh;
+    ok &= sh.feedBinary(trace).ok() && sh.best() == inMemory;
+    auto t2 = chrono::high_resolution_clock::now();
+    fclose(trace);
+    double msMem = chrono::duration<double, milli>(t1 - t0).count(), msStream = chrono::duration<double, milli>(t2 - t1).count();
+    cout << "\nstream of " << all.size() << " bars: in-memory " << inMemory << " (" << msMem << " ms, "
+         << bytes / 1e6 / (msMem / 1e3) << " MB/s), streaming " << sh.best() << " (" << msStream << " ms, "
+         << bytes / 1e6 / (msStream / 1e3) << " MB/s), stack depth " << sh.depth() << "\n";
+    return ok ? 0 : 1;
 }
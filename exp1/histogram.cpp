@@ -0,0 +1,114 @@
+// histogram.cpp
+#include "histogram.h"
+
+#include <climits>
+using namespace std;
+
+namespace ds2025::exp1 {
+
+long long largestRectangleArea(const int* h, size_t n, vector<long long>& stk) {
+    if (stk.size() < n) stk.resize(n);
+    long long depth = 0, open = 0;
+    long long best = stackKernel(h, (long long)n, stk.data(), depth, [&](long long j, long long r) {
+        open = max(open, (long long)h[j] * r);
+    });
+    for (long long k = depth - 1; k >= 0; --k)
+        best = max(best, (long long)h[stk[k]] * ((long long)n - (k > 0 ? stk[k - 1] : -1) - 1));
+    return max(best, open);
+}
+
+long long largestRectangleArea(const vector<int>& heights) {
+    vector<long long> stk;
+    return largestRectangleArea(heights.data(), heights.size(), stk);
+}
+
+long long largestRectangleAreaParallel(const int* h, size_t n, unsigned threads) {
+    threads = max(1u, threads);
+    if (n < (size_t)threads * 4096) {
+        vector<long long> stk;
+        return largestRectangleArea(h, n, stk);
+    }
+    struct Segment {
+        long long begin, end, best = 0;
+        int minH = INT_MAX;
+        vector<pair<long long, long long>> open;   // (index, right); left is outside the segment
+        vector<long long> stack;                   // unclosed bars; right is outside the segment
+        vector<long long> prefixMins, suffixMins;  // strict minima records, in index order
+    };
+    vector<Segment> seg(threads);
+    size_t chunk = (n + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        seg[t].begin = (long long)min(n, t * chunk);
+        seg[t].end = (long long)min(n, (t + 1) * chunk);
+    }
+
+    auto work = [&](Segment& s) {
+        long long len = s.end - s.begin, depth = 0;
+        const int* hs = h + s.begin;
+        s.stack.resize(len);
+        s.best = stackKernel(hs, len, s.stack.data(), depth, [&](long long j, long long r) {
+            s.open.push_back({j + s.begin, r + s.begin});
+        });
+        s.stack.resize(depth);
+        for (auto& j : s.stack) j += s.begin;
+        for (size_t k = 0; k < s.stack.size(); ++k)  // the stack is non-decreasing: keep the last of each run
+            if (k + 1 == s.stack.size() || h[s.stack[k + 1]] > h[s.stack[k]]) s.suffixMins.push_back(s.stack[k]);
+        for (long long i = 0; i < len; ++i)
+            if (hs[i] < s.minH) { s.minH = hs[i]; s.prefixMins.push_back(i + s.begin); }
+    };
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(work, ref(seg[t]));
+    work(seg[0]);
+    for (auto& th : pool) th.join();
+
+    // profile holds indices with strictly increasing heights; the nearest bar lower than x
+    // is the last one with height < x, or `none`
+    auto nearestLower = [&](const vector<long long>& profile, int x, long long none) {
+        auto it = partition_point(profile.begin(), profile.end(), [&](long long i) { return h[i] < x; });
+        return it == profile.begin() ? none : *prev(it);
+    };
+    long long best = 0;
+    vector<long long> profile;
+    vector<long long> bottomLeft(threads, -1);  // left end of each segment's lowest unclosed bar
+    for (unsigned t = 0; t < threads; ++t) {
+        Segment& s = seg[t];
+        best = max(best, s.best);
+        for (auto& o : s.open)
+            best = max(best, (long long)h[o.first] * (o.second - nearestLower(profile, h[o.first], -1) - 1));
+        if (!s.stack.empty()) bottomLeft[t] = nearestLower(profile, h[s.stack[0]], -1);
+        while (!profile.empty() && h[profile.back()] >= s.minH) profile.pop_back();
+        profile.insert(profile.end(), s.suffixMins.begin(), s.suffixMins.end());
+    }
+    profile.clear();  // now stored back = leftmost, so heights still increase along the vector
+    for (unsigned t = threads; t-- > 0; ) {
+        Segment& s = seg[t];
+        for (size_t k = 0; k < s.stack.size(); ++k) {
+            long long j = s.stack[k];
+            long long left = k == 0 ? bottomLeft[t] : s.stack[k - 1];
+            best = max(best, (long long)h[j] * (nearestLower(profile, h[j], (long long)n) - left - 1));
+        }
+        while (!profile.empty() && h[profile.back()] >= s.minH) profile.pop_back();
+        profile.insert(profile.end(), s.prefixMins.rbegin(), s.prefixMins.rend());
+    }
+    return best;
+}
+
+long long maximalRectangle(const BitMatrix& m) {
+    vector<int> heights(m.cols, 0);
+    vector<long long> stk(m.cols);
+    long long best = 0;
+    for (int r = 0; r < m.rows; ++r) {
+        const uint64_t* row = &m.bits[r * m.wordsPerRow];
+        for (size_t w = 0; w < m.wordsPerRow; ++w) {
+            int c0 = (int)w * 64, c1 = min(m.cols, c0 + 64);
+            uint64_t word = row[w];
+            if (word == 0) fill(heights.begin() + c0, heights.begin() + c1, 0);
+            else if (word == ~0ULL) for (int c = c0; c < c1; ++c) ++heights[c];
+            else for (int c = c0; c < c1; ++c) heights[c] = (word >> (c - c0) & 1) ? heights[c] + 1 : 0;
+        }
+        best = max(best, largestRectangleArea(heights.data(), heights.size(), stk));
+    }
+    return best;
+}
+
+}  // namespace ds2025::exp1
@@ -0,0 +1,164 @@
+// histogram.h - largest rectangle in a histogram: serial, parallel, streaming and 2-D (exp1 part 3)
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace ds2025::exp1 {
+
+// Monotonic-stack pass over h[0..n) without the final flush; stk must hold n entries and
+// areas are 64-bit. Bars closed with a lower bar on both sides are scored here. Bars closed
+// with nothing lower to their left go to onOpen(index, right) and the bars never closed are
+// left in stk[0..depth), so callers decide how to resolve the missing sides.
+template <typename OnOpen>
+long long stackKernel(const int* h, long long n, long long* stk, long long& depth, OnOpen onOpen) {
+    long long top = -1;
+    long long best = 0;
+    for (long long i = 0; i < n; ++i) {
+        int cur = h[i];
+        while (top >= 0 && cur < h[stk[top]]) {
+            long long j = stk[top--];
+            if (top < 0) onOpen(j, i);
+            else best = std::max(best, (long long)h[j] * (i - stk[top] - 1));
+        }
+        stk[++top] = i;
+    }
+    depth = top + 1;
+    return best;
+}
+
+// stk is scratch reused across calls
+long long largestRectangleArea(const int* h, size_t n, std::vector<long long>& stk);
+
+long long largestRectangleArea(const std::vector<int>& heights);
+
+// Parallel divide and conquer: every segment runs the kernel independently; bars whose
+// extent leaves their segment are then resolved against the left profile (strict suffix
+// minima of everything before the segment) and right profile (strict prefix minima of
+// everything after it), which are built in one sweep each over the segment profiles.
+long long largestRectangleAreaParallel(const int* h, size_t n, unsigned threads = std::thread::hardware_concurrency());
+
+// Binary matrix with each row packed into 64-bit words (bit c%64 of word c/64)
+struct BitMatrix {
+    int rows, cols;
+    size_t wordsPerRow;
+    std::vector<uint64_t> bits;
+    BitMatrix(int r, int c) : rows(r), cols(c), wordsPerRow((c + 63) / 64), bits((size_t)r * ((c + 63) / 64), 0) {}
+    void set(int r, int c) { bits[r * wordsPerRow + c / 64] |= 1ULL << (c % 64); }
+    bool get(int r, int c) const { return bits[r * wordsPerRow + c / 64] >> (c % 64) & 1; }
+};
+
+// Largest all-ones rectangle: per row, column heights of consecutive ones feed the
+// histogram kernel; whole zero / all-ones words are updated without testing bits.
+long long maximalRectangle(const BitMatrix& m);
+
+// Incremental largest rectangle: heights arrive one at a time and only the monotonic
+// stack of (start, height) runs is kept, so memory is bounded by the stack depth.
+// Heights passed to push() must be non-negative; the feeders check their input.
+class StreamingHistogram {
+public:
+    void push(int h) {
+        long long start = count;
+        while (!runs.empty() && runs.back().height > h) {
+            Run r = runs.back(); runs.pop_back();
+            closed = std::max(closed, (long long)r.height * (count - r.start));
+            start = r.start;
+        }
+        if (runs.empty() || runs.back().height < h) runs.push_back({start, h});
+        ++count;
+    }
+    void push(const int* h, size_t n) { for (size_t i = 0; i < n; ++i) push(h[i]); }
+
+    // best area over everything pushed so far (open runs extend to the current end)
+    long long best() const {
+        long long b = closed;
+        for (auto& r : runs) b = std::max(b, (long long)r.height * (count - r.start));
+        return b;
+    }
+    long long size() const { return count; }
+    size_t depth() const { return runs.size(); }
+
+    // Input the feeders rejected. Rejected values are counted and skipped, never pushed.
+    struct FeedErrors {
+        long long negative = 0;     // heights below zero
+        long long overflow = 0;     // text values above INT_MAX
+        long long malformed = 0;    // text tokens that are not an optionally signed integer
+        size_t trailingBytes = 0;   // binary input ending in a partial int32 record
+        bool ok() const { return negative == 0 && overflow == 0 && malformed == 0 && trailingBytes == 0; }
+    };
+
+    // raw native-endian int32 heights, read in fixed-size chunks; a record split across two
+    // chunks is carried over
+    FeedErrors feedBinary(FILE* f) {
+        FeedErrors err;
+        std::vector<int> buf(1 << 16);
+        char* bytes = reinterpret_cast<char*>(buf.data());
+        size_t have = 0, got;
+        while ((got = fread(bytes + have, 1, buf.size() * sizeof(int) - have, f)) > 0) {
+            have += got;
+            size_t n = have / sizeof(int);
+            for (size_t i = 0; i < n; ++i) {
+                if (buf[i] < 0) ++err.negative;
+                else push(buf[i]);
+            }
+            have -= n * sizeof(int);
+            memmove(bytes, bytes + n * sizeof(int), have);
+        }
+        err.trailingBytes = have;
+        return err;
+    }
+
+    // whitespace-separated decimal heights; a number split across two chunks is carried over.
+    // A '-' is only a sign as the first character of a token, so "5-3" is one malformed token.
+    FeedErrors feedText(FILE* f) {
+        FeedErrors err;
+        std::vector<char> buf(1 << 16);
+        long long val = 0;      // stops growing once above INT_MAX
+        size_t len = 0;         // characters of the current token
+        bool digits = false, negative = false, bad = false;
+        auto flush = [&] {
+            if (len == 0) return;
+            if (bad || !digits) ++err.malformed;
+            else if (negative && val != 0) ++err.negative;
+            else if (val > INT_MAX) ++err.overflow;
+            else push(int(val));
+        };
+        size_t got;
+        while ((got = fread(buf.data(), 1, buf.size(), f)) > 0) {
+            for (size_t i = 0; i < got; ++i) {
+                char c = buf[i];
+                if (isspace((unsigned char)c)) {
+                    flush();
+                    val = 0; len = 0; digits = negative = bad = false;
+                    continue;
+                }
+                if (c >= '0' && c <= '9') {
+                    if (val <= INT_MAX) val = val * 10 + (c - '0');
+                    digits = true;
+                }
+                else if (c == '-' && len == 0) negative = true;
+                else bad = true;
+                ++len;
+            }
+        }
+        flush();
+        return err;
+    }
+
+private:
+    struct Run { long long start; int height; };
+    std::vector<Run> runs;
+    long long count = 0, closed = 0;
+};
+
+}  // namespace ds2025::exp1
+
+#endif
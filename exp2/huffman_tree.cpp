@@ -0,0 +1,37 @@
+// huffman_tree.cpp
+#include "huffman_tree.h"
+
+#include <queue>
+#include <vector>
+using namespace std;
+
+namespace ds2025::exp2 {
+
+HuffNode* buildHuffmanTree(const unordered_map<char,int>& freq) {
+    priority_queue<HuffNode*, vector<HuffNode*>, cmp> pq;
+    for (auto &p : freq) pq.push(new HuffNode(p.first, p.second));
+    if (pq.empty()) return nullptr;
+
+    while (pq.size() > 1) {
+        HuffNode* a = pq.top(); pq.pop();
+        HuffNode* b = pq.top(); pq.pop();
+        pq.push(new HuffNode(a, b));
+    }
+    return pq.top();
+}
+
+void freeHuffmanTree(HuffNode* root) {
+    if (!root) return;
+    freeHuffmanTree(root->lc);
+    freeHuffmanTree(root->rc);
+    delete root;
+}
+
+void generateCodes(HuffNode* root, string path, unordered_map<char,string>& code) {
+    if (!root) return;
+    if (root->ch != 0) code[root->ch] = path;
+    generateCodes(root->lc, path + "0", code);
+    generateCodes(root->rc, path + "1", code);
+}
+
+}  // namespace ds2025::exp2
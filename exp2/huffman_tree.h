@@ -0,0 +1,88 @@
+// huffman_tree.h - bitmap, binary tree and Huffman coding (exp2)
+#ifndef HUFFMAN_TREE_H
+#define HUFFMAN_TREE_H
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace ds2025::exp2 {
+
+class Bitmap {
+private:
+    unsigned char* M;
+    int N, _sz;
+
+    void init(int n) {
+        M = new unsigned char[N = (n + 7) / 8];
+        std::memset(M, 0, N);
+        _sz = 0;
+    }
+
+public:
+    Bitmap(int n = 8) { init(n); }
+    ~Bitmap() { delete[] M; }
+
+    void expand(int k) {
+        if (k < 8 * N) return;
+        int oldN = N;
+        unsigned char* oldM = M;
+        init(2 * k);
+        std::memcpy(M, oldM, oldN);
+        delete[] oldM;
+    }
+
+    void set(int k) {
+        if (k >= 8 * N) expand(k);
+        M[k >> 3] |= (0x80 >> (k & 7));
+        _sz++;
+    }
+
+    bool test(int k) const {
+        return M[k >> 3] & (0x80 >> (k & 7));
+    }
+};
+
+template <typename T>
+struct BinNode {
+    T data;
+    BinNode *lc, *rc, *parent;
+    BinNode(T v, BinNode* p=nullptr) : data(v), lc(nullptr), rc(nullptr), parent(p) {}
+};
+
+template <typename T>
+class BinTree {
+public:
+    BinNode<T>* _root;
+    int _size;
+    BinTree(): _root(nullptr), _size(0) {}
+    BinNode<T>* insertAsRoot(T const& e) {
+        _size = 1;
+        return _root = new BinNode<T>(e);
+    }
+};
+
+struct HuffNode {
+    char ch;
+    int freq;
+    HuffNode *lc, *rc;
+    HuffNode(char c, int f) : ch(c), freq(f), lc(nullptr), rc(nullptr) {}
+    HuffNode(HuffNode* a, HuffNode* b)
+        : ch(0), freq(a->freq + b->freq), lc(a), rc(b) {}
+};
+
+struct cmp {
+    bool operator()(HuffNode* a, HuffNode* b) {
+        return a->freq > b->freq;
+    }
+};
+
+// Repeatedly merges the two least frequent trees; returns nullptr for an empty table
+HuffNode* buildHuffmanTree(const std::unordered_map<char,int>& freq);
+void freeHuffmanTree(HuffNode* root);
+
+void generateCodes(HuffNode* root, std::string path, std::unordered_map<char,std::string>& code);
+
+}  // namespace ds2025::exp2
+
+#endif
@@ -0,0 +1,281 @@
+// apsp.cpp
+#include "apsp.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+#include "../common/parallel.h"
+#include "../common/trace.h"
+#include "graph.h"
+using namespace std;
+
+namespace ds2025::exp3 {
+
+namespace {
+
+const int kBlock = 64;                          // 块边长，一块16KB，三块同时驻留L1/L2
+const size_t kTileCells = (size_t)kBlock * kBlock;
+
+// 非负距离的饱和加法：按无符号相加不会溢出，再截断到kUnreachable
+inline int32_t satAdd(int32_t a, int32_t b) {
+    uint32_t s = (uint32_t)a + (uint32_t)b;
+    return s < (uint32_t)kUnreachable ? (int32_t)s : kUnreachable;
+}
+
+// c[j] = min(c[j], a + b[j])，j ∈ [0, kBlock)
+inline void relaxRow(int32_t* c, const int32_t* b, int32_t a) {
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi32(a), inf = _mm256_set1_epi32(kUnreachable);
+    for (int j = 0; j < kBlock; j += 8) {
+        __m256i s = _mm256_min_epu32(_mm256_add_epi32(va, _mm256_loadu_si256((const __m256i*)(b + j))), inf);
+        __m256i* p = (__m256i*)(c + j);
+        _mm256_storeu_si256(p, _mm256_min_epi32(_mm256_loadu_si256(p), s));
+    }
+#elif defined(__SSE4_1__)
+    const __m128i va = _mm_set1_epi32(a), inf = _mm_set1_epi32(kUnreachable);
+    for (int j = 0; j < kBlock; j += 4) {
+        __m128i s = _mm_min_epu32(_mm_add_epi32(va, _mm_loadu_si128((const __m128i*)(b + j))), inf);
+        __m128i* p = (__m128i*)(c + j);
+        _mm_storeu_si128(p, _mm_min_epi32(_mm_loadu_si128(p), s));
+    }
+#else
+    for (int j = 0; j < kBlock; ++j) c[j] = min(c[j], satAdd(a, b[j]));
+#endif
+}
+
+// 带依赖的块更新（阶段1、2）：C可能与A或B是同一块，必须以k为最外层
+void fwTile(int32_t* c, const int32_t* a, const int32_t* b) {
+    for (int k = 0; k < kBlock; ++k) {
+        const int32_t* bk = b + k * kBlock;
+        for (int i = 0; i < kBlock; ++i) {
+            int32_t aik = a[i * kBlock + k];
+            if (aik != kUnreachable) relaxRow(c + i * kBlock, bk, aik);
+        }
+    }
+}
+
+// 独立块的min-plus乘加（阶段3）：C = min(C, A ⊗ B)，C的一行常驻寄存器
+void minPlusTile(int32_t* c, const int32_t* a, const int32_t* b) {
+    for (int i = 0; i < kBlock; ++i) {
+        int32_t* ci = c + i * kBlock;
+        const int32_t* ai = a + i * kBlock;
+#if defined(__AVX2__)
+        const __m256i inf = _mm256_set1_epi32(kUnreachable);
+        __m256i acc[kBlock / 8];
+        for (int j = 0; j < kBlock / 8; ++j) acc[j] = _mm256_loadu_si256((const __m256i*)ci + j);
+        for (int k = 0; k < kBlock; ++k) {
+            if (ai[k] == kUnreachable) continue;
+            const __m256i va = _mm256_set1_epi32(ai[k]);
+            const __m256i* bk = (const __m256i*)(b + k * kBlock);
+            for (int j = 0; j < kBlock / 8; ++j)
+                acc[j] = _mm256_min_epi32(acc[j], _mm256_min_epu32(_mm256_add_epi32(va, _mm256_loadu_si256(bk + j)), inf));
+        }
+        for (int j = 0; j < kBlock / 8; ++j) _mm256_storeu_si256((__m256i*)ci + j, acc[j]);
+#else
+        for (int k = 0; k < kBlock; ++k)
+            if (ai[k] != kUnreachable) relaxRow(ci, b + k * kBlock, ai[k]);
+#endif
+    }
+}
+
+// 按块存放的工作矩阵：块(ib, jb)是连续的kBlock×kBlock区域，边长补齐到kBlock的倍数，
+// 补齐的节点没有边，不影响结果
+class TiledMatrix {
+public:
+    explicit TiledMatrix(int32_t n) : n(n), nb((n + kBlock - 1) / kBlock), cells((size_t)nb * nb * kTileCells, kUnreachable) {
+        for (int32_t v = 0; v < nb * kBlock; ++v) cell(v, v) = 0;
+    }
+
+    int32_t& cell(int32_t u, int32_t v) {
+        return tile(u / kBlock, v / kBlock)[(u % kBlock) * kBlock + v % kBlock];
+    }
+    int32_t* tile(int32_t ib, int32_t jb) { return cells.data() + ((size_t)ib * nb + jb) * kTileCells; }
+    int32_t blocks() const { return nb; }
+
+    DistMatrix toDistMatrix() {
+        DistMatrix d;
+        d.rows = d.cols = n;
+        d.cells.resize((size_t)n * n);
+        for (int32_t u = 0; u < n; ++u)
+            for (int32_t jb = 0; jb < nb; ++jb) {
+                int32_t len = min(kBlock, n - jb * kBlock);
+                memcpy(d.row(u) + jb * kBlock, tile(u / kBlock, jb) + (u % kBlock) * kBlock, len * sizeof(int32_t));
+            }
+        return d;
+    }
+
+private:
+    int32_t n, nb;
+    vector<int32_t> cells;
+};
+
+// 分块Floyd-Warshall：对每个主元块kb，先更新对角块，再并行更新第kb行/列的块，最后并行更新其余块
+void blockedFloydWarshall(TiledMatrix& m, unsigned threads) {
+    int32_t nb = m.blocks();
+    for (int32_t kb = 0; kb < nb; ++kb) {
+        int32_t* kk = m.tile(kb, kb);
+        fwTile(kk, kk, kk);
+        common::parallelChunks(2 * (int64_t)nb, threads, 1, [&](int64_t b, int64_t e) {
+            for (int64_t t = b; t < e; ++t) {
+                int32_t j = (int32_t)(t / 2);
+                if (j == kb) continue;
+                if (t % 2 == 0) fwTile(m.tile(kb, j), kk, m.tile(kb, j));
+                else fwTile(m.tile(j, kb), m.tile(j, kb), kk);
+            }
+        });
+        common::parallelChunks(nb, threads, 1, [&](int64_t b, int64_t e) {
+            for (int32_t ib = (int32_t)b; ib < e; ++ib) {
+                if (ib == kb) continue;
+                const int32_t* ik = m.tile(ib, kb);
+                for (int32_t jb = 0; jb < nb; ++jb)
+                    if (jb != kb) minPlusTile(m.tile(ib, jb), ik, m.tile(kb, jb));
+            }
+        });
+    }
+}
+
+// 平均出度不少于 n/kDenseRatio 时用Floyd-Warshall，否则逐源点Dijkstra
+// （按实测交叉点：AVX2内核约快4倍，较稀疏的图也值得用Floyd-Warshall）
+#if defined(__AVX2__)
+const int64_t kDenseRatio = 256;
+#else
+const int64_t kDenseRatio = 64;
+#endif
+
+const char kDistMagic[8] = {'D', 'S', 'D', 'I', 'S', 'T', '0', '1'};
+
+struct DistHeader {
+    char magic[8];
+    int32_t rows, cols;
+    char reserved[48];                          // 补齐到64字节，数据按缓存行对齐
+};
+static_assert(sizeof(DistHeader) == 64, "DistHeader must be 64 bytes");
+
+}  // namespace
+
+DistMatrix floydWarshall(const Graph& g, unsigned threads) {
+    TRACE_SCOPE("floydWarshall");
+    TiledMatrix m(g.n);
+    for (int u = 0; u < g.n; ++u)
+        for (int v = 0; v < g.n; ++v)
+            if (u != v && g.adjMatrix[u][v] > 0) m.cell(u, v) = g.adjMatrix[u][v];
+    blockedFloydWarshall(m, threads);
+    return m.toDistMatrix();
+}
+
+DistMatrix floydWarshall(const CsrGraph& g, unsigned threads) {
+    TRACE_SCOPE("floydWarshall");
+    TiledMatrix m(g.n);
+    for (int32_t u = 0; u < g.n; ++u)
+        for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            int32_t& c = m.cell(u, g.targets[e]);
+            c = min(c, g.weights[e]);               // 重边取最小权值
+        }
+    blockedFloydWarshall(m, threads);
+    return m.toDistMatrix();
+}
+
+DistMatrix floydWarshallNaive(const Graph& g) {
+    DistMatrix d;
+    d.rows = d.cols = g.n;
+    d.cells.assign((size_t)g.n * g.n, kUnreachable);
+    for (int u = 0; u < g.n; ++u)
+        for (int v = 0; v < g.n; ++v)
+            if (u == v) d.row(u)[v] = 0;
+            else if (g.adjMatrix[u][v] > 0) d.row(u)[v] = g.adjMatrix[u][v];
+    for (int k = 0; k < g.n; ++k)
+        for (int i = 0; i < g.n; ++i)
+            for (int j = 0; j < g.n; ++j)
+                d.row(i)[j] = min(d.row(i)[j], satAdd(d.row(i)[k], d.row(k)[j]));
+    return d;
+}
+
+DistMatrix multiSourceDijkstra(const CsrGraph& g, const vector<int32_t>& sources, unsigned threads) {
+    TRACE_SCOPE("multiSourceDijkstra");
+    DistMatrix d;
+    d.rows = (int32_t)sources.size();
+    d.cols = g.n;
+    d.cells.assign((size_t)d.rows * d.cols, kUnreachable);
+    common::parallelChunks(d.rows, threads, 8, [&](int64_t b, int64_t e) {
+        vector<uint64_t> heap;                  // (距离 << 32) | 节点，整块源点复用
+        for (int64_t r = b; r < e; ++r) {
+            int32_t* dist = d.row((int32_t)r);  // 直接写入结果行，不另开数组
+            int32_t s = sources[r];
+            dist[s] = 0;
+            heap.assign(1, (uint64_t)s);
+            while (!heap.empty()) {
+                pop_heap(heap.begin(), heap.end(), greater<uint64_t>());
+                uint64_t top = heap.back();
+                heap.pop_back();
+                int32_t du = (int32_t)(top >> 32), u = (int32_t)(uint32_t)top;
+                if (du != dist[u]) continue; // 过期条目
+                for (int64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                    int32_t v = g.targets[i];
+                    int64_t nd = (int64_t)du + g.weights[i];
+                    if (nd < dist[v]) {
+                        dist[v] = (int32_t)nd;
+                        heap.push_back((uint64_t)nd << 32 | (uint32_t)v);
+                        push_heap(heap.begin(), heap.end(), greater<uint64_t>());
+                    }
+                }
+            }
+        }
+    });
+    return d;
+}
+
+DistMatrix allPairsShortestPaths(const CsrGraph& g, unsigned threads) {
+    if (g.edgeCount() * kDenseRatio >= (int64_t)g.n * g.n) return floydWarshall(g, threads);
+    vector<int32_t> sources(g.n);
+    for (int32_t v = 0; v < g.n; ++v) sources[v] = v;
+    return multiSourceDijkstra(g, sources, threads);
+}
+
+void writeDistMatrix(const DistMatrix& m, const string& path) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) throw runtime_error("Cannot open " + path);
+    DistHeader h = {};
+    memcpy(h.magic, kDistMagic, sizeof(h.magic));
+    h.rows = m.rows;
+    h.cols = m.cols;
+    bool good = fwrite(&h, sizeof(h), 1, f) == 1 &&
+                fwrite(m.cells.data(), sizeof(int32_t), m.cells.size(), f) == m.cells.size();
+    good = fclose(f) == 0 && good;
+    if (!good) throw runtime_error("Write failed: " + path);
+}
+
+MappedDistMatrix::MappedDistMatrix(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw runtime_error("Cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(DistHeader)) {
+        close(fd);
+        throw runtime_error("Not a distance matrix file: " + path);
+    }
+    bytes = (size_t)st.st_size;
+    base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) throw runtime_error(string("mmap: ") + strerror(errno));
+    const DistHeader* h = (const DistHeader*)base;
+    if (memcmp(h->magic, kDistMagic, sizeof(h->magic)) != 0 || h->rows < 0 || h->cols < 0 ||
+        bytes != sizeof(DistHeader) + (size_t)h->rows * h->cols * sizeof(int32_t)) {
+        munmap(base, bytes);
+        throw runtime_error("Not a distance matrix file: " + path);
+    }
+    rowCount = h->rows;
+    colCount = h->cols;
+    cells = (const int32_t*)((const char*)base + sizeof(DistHeader));
+}
+
+MappedDistMatrix::~MappedDistMatrix() { munmap(base, bytes); }
+
+}  // namespace ds2025::exp3
@@ -0,0 +1,77 @@
+// apsp.h - 全源/多源最短路径距离矩阵（实验3扩展）
+//
+// 稠密图用分块Floyd-Warshall：矩阵按64×64的块连续存放，min-plus内核用饱和加法，
+// 编译时启用AVX2/SSE4.1（如 -DDS2025_NATIVE=ON）则使用SIMD，否则为标量循环。
+// 稀疏图用多线程多源Dijkstra，每个线程复用自己的堆。
+// 距离为int32，kUnreachable表示不可达；要求权值非负且最短距离小于INT32_MAX。
+#ifndef APSP_H
+#define APSP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "csr_graph.h"
+
+namespace ds2025::exp3 {
+
+class Graph;
+
+const int32_t kUnreachable = INT32_MAX;
+
+// rows×cols 行主序的紧凑距离矩阵，第r行为第r个源点到所有节点的距离
+struct DistMatrix {
+    int32_t rows = 0;
+    int32_t cols = 0;
+    std::vector<int32_t> cells;
+
+    int32_t* row(int32_t r) { return cells.data() + (size_t)r * cols; }
+    const int32_t* row(int32_t r) const { return cells.data() + (size_t)r * cols; }
+    int32_t at(int32_t r, int32_t c) const { return cells[(size_t)r * cols + c]; }
+};
+
+// ========================= 全源最短路径 =========================
+// 邻接矩阵图（权值>0的非对角元素为边）
+DistMatrix floydWarshall(const Graph& g, unsigned threads = std::thread::hardware_concurrency());
+DistMatrix floydWarshall(const CsrGraph& g, unsigned threads = std::thread::hardware_concurrency());
+
+// 三重循环（参考实现）
+DistMatrix floydWarshallNaive(const Graph& g);
+
+// 从sources中每个源点各做一次Dijkstra，结果第i行对应sources[i]
+DistMatrix multiSourceDijkstra(const CsrGraph& g, const std::vector<int32_t>& sources,
+                               unsigned threads = std::thread::hardware_concurrency());
+
+// 按边密度在分块Floyd-Warshall与多源Dijkstra之间选择
+DistMatrix allPairsShortestPaths(const CsrGraph& g, unsigned threads = std::thread::hardware_concurrency());
+
+// ========================= 距离矩阵文件 =========================
+// 64字节头部（魔数"DSDIST01"、rows、cols）后紧跟行主序的int32数据，
+// 可直接mmap按行读取。读写失败抛出runtime_error。
+void writeDistMatrix(const DistMatrix& m, const std::string& path);
+
+// 只读映射距离矩阵文件，不把整个矩阵读入内存
+class MappedDistMatrix {
+public:
+    explicit MappedDistMatrix(const std::string& path);
+    ~MappedDistMatrix();
+    MappedDistMatrix(const MappedDistMatrix&) = delete;
+    MappedDistMatrix& operator=(const MappedDistMatrix&) = delete;
+
+    int32_t rows() const { return rowCount; }
+    int32_t cols() const { return colCount; }
+    const int32_t* row(int32_t r) const { return cells + (size_t)r * colCount; }
+    int32_t at(int32_t r, int32_t c) const { return cells[(size_t)r * colCount + c]; }
+
+private:
+    void* base = nullptr;
+    size_t bytes = 0;
+    int32_t rowCount = 0;
+    int32_t colCount = 0;
+    const int32_t* cells = nullptr;
+};
+
+}  // namespace ds2025::exp3
+
+#endif
@@ -0,0 +1,344 @@
+// components.cpp
+#include "components.h"
+
+#include <algorithm>
+#include <climits>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include "../common/parallel.h"
+#include "traversal.h"
+using namespace std;
+
+namespace ds2025::exp3 {
+
+namespace {
+
+// 把任意代表编号换成分量内最小节点编号
+void normalize(vector<int32_t>& comp) {
+    vector<int32_t> minOf(comp.size(), INT32_MAX);
+    for (int32_t v = 0; v < (int32_t)comp.size(); ++v) minOf[comp[v]] = min(minOf[comp[v]], v);
+    for (auto& c : comp) c = minOf[c];
+}
+
+// 迭代Tarjan，只访问active(v)为真的节点；comp[v]记为SCC的根节点
+template <typename Active>
+void tarjanRestricted(const CsrGraph& g, Active active, vector<int32_t>& comp) {
+    vector<int32_t> index(g.n, -1), low(g.n, 0);
+    vector<char> onStack(g.n, 0);
+    vector<int32_t> sccStack;
+    vector<pair<int32_t, int64_t>> call; // (节点, 下一条待检查的边)
+    int32_t counter = 0;
+    for (int32_t s = 0; s < g.n; ++s) {
+        if (index[s] != -1 || !active(s)) continue;
+        index[s] = low[s] = counter++;
+        sccStack.push_back(s);
+        onStack[s] = 1;
+        call.push_back({s, g.offsets[s]});
+        while (!call.empty()) {
+            int32_t v = call.back().first;
+            int64_t& e = call.back().second;
+            if (e < g.offsets[v + 1]) {
+                int32_t w = g.targets[e++];
+                if (!active(w)) continue;
+                if (index[w] == -1) {
+                    index[w] = low[w] = counter++;
+                    sccStack.push_back(w);
+                    onStack[w] = 1;
+                    call.push_back({w, g.offsets[w]}); // e在此之后失效
+                } else if (onStack[w]) {
+                    low[v] = min(low[v], index[w]);
+                }
+                continue;
+            }
+            call.pop_back();
+            if (!call.empty()) {
+                int32_t u = call.back().first;
+                low[u] = min(low[u], low[v]);
+            }
+            if (low[v] == index[v]) {
+                int32_t w;
+                do {
+                    w = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[w] = 0;
+                    comp[w] = v;
+                } while (w != v);
+            }
+        }
+    }
+}
+
+using Flags = unique_ptr<atomic<uint8_t>[]>;
+
+Flags makeFlags(int32_t n, uint8_t value) {
+    Flags f(new atomic<uint8_t>[n]);
+    for (int32_t i = 0; i < n; ++i) f[i].store(value, memory_order_relaxed);
+    return f;
+}
+
+bool hasActiveNeighbor(const CsrGraph& g, int32_t v, const Flags& active) {
+    for (int64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e)
+        if (g.targets[e] != v && active[g.targets[e]].load(memory_order_relaxed)) return true;
+    return false;
+}
+
+// 层同步并行BFS，只走active节点；返回所有到达的节点（含src），mark置1
+vector<int32_t> parallelReach(const CsrGraph& g, int32_t src, const Flags& active, const Flags& mark,
+                              unsigned threads) {
+    vector<int32_t> reached = {src}, frontier = {src}, next;
+    mutex m;
+    mark[src].store(1, memory_order_relaxed);
+    while (!frontier.empty()) {
+        next.clear();
+        common::parallelChunks((int64_t)frontier.size(), threads, 256, [&](int64_t b, int64_t e) {
+            vector<int32_t> local;
+            for (int64_t i = b; i < e; ++i) {
+                int32_t u = frontier[i];
+                for (int64_t k = g.offsets[u]; k < g.offsets[u + 1]; ++k) {
+                    int32_t w = g.targets[k];
+                    if (active[w].load(memory_order_relaxed) && !mark[w].load(memory_order_relaxed) &&
+                        mark[w].exchange(1, memory_order_relaxed) == 0)
+                        local.push_back(w);
+                }
+            }
+            lock_guard<mutex> lk(m);
+            next.insert(next.end(), local.begin(), local.end());
+        });
+        reached.insert(reached.end(), next.begin(), next.end());
+        frontier.swap(next);
+    }
+    return reached;
+}
+
+}  // namespace
+
+// ========================= 无向图连通分量 =========================
+vector<int32_t> connectedComponents(const CsrGraph& g, unsigned threads) {
+    const int kNeighborRounds = 2;
+    const int64_t kGrain = 4096;
+    int32_t n = g.n;
+    ConcurrentUnionFind uf(n);
+    auto compressAll = [&] {
+        common::parallelChunks(n, threads, kGrain, [&](int64_t b, int64_t e) { uf.compress((int32_t)b, (int32_t)e); });
+    };
+
+    // 1. 每个节点只连第r条边，多数节点此时已并入最大分量
+    for (int r = 0; r < kNeighborRounds; ++r) {
+        common::parallelChunks(n, threads, kGrain, [&](int64_t b, int64_t e) {
+            for (int32_t v = (int32_t)b; v < e; ++v)
+                if (g.degree(v) > r) uf.unite(v, g.targets[g.offsets[v] + r]);
+        });
+        compressAll();
+    }
+
+    // 2. 采样估计最大分量
+    int32_t largest = 0;
+    if (n > 0) {
+        unordered_map<int32_t, int> freq;
+        mt19937 gen(2025);
+        uniform_int_distribution<int32_t> pick(0, n - 1);
+        int best = 0;
+        for (int i = 0; i < 1024; ++i) {
+            int32_t c = uf.parentOf(pick(gen));
+            if (++freq[c] > best) { best = freq[c]; largest = c; }
+        }
+    }
+
+    // 3. 最大分量之外的节点处理剩余的边（对称图中跨分量的边总能从分量外一侧看到）
+    common::parallelChunks(n, threads, 256, [&](int64_t b, int64_t e) {
+        for (int32_t v = (int32_t)b; v < e; ++v) {
+            if (uf.parentOf(v) == largest) continue;
+            for (int64_t k = g.offsets[v] + kNeighborRounds; k < g.offsets[v + 1]; ++k) uf.unite(v, g.targets[k]);
+        }
+    });
+    compressAll();
+
+    vector<int32_t> comp(n);
+    for (int32_t v = 0; v < n; ++v) comp[v] = uf.parentOf(v);
+    return comp;
+}
+
+vector<int32_t> connectedComponentsBFS(const CsrGraph& g) {
+    vector<int32_t> comp(g.n, -1), queue;
+    for (int32_t s = 0; s < g.n; ++s) {
+        if (comp[s] != -1) continue;
+        comp[s] = s;
+        queue.assign(1, s);
+        for (size_t i = 0; i < queue.size(); ++i) {
+            int32_t u = queue[i];
+            for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                int32_t v = g.targets[e];
+                if (comp[v] == -1) { comp[v] = s; queue.push_back(v); }
+            }
+        }
+    }
+    return comp;
+}
+
+// ========================= 有向图强连通分量 =========================
+vector<int32_t> tarjanSCC(const CsrGraph& g) {
+    vector<int32_t> comp(g.n, -1);
+    tarjanRestricted(g, [](int32_t) { return true; }, comp);
+    normalize(comp);
+    return comp;
+}
+
+vector<int32_t> kosarajuSCC(const CsrGraph& g) {
+    // 第一遍：正向图上迭代DFS，记录完成顺序
+    struct FinishOrder : TraversalVisitor {
+        vector<int32_t> order;
+        void finish(int32_t v) { order.push_back(v); }
+    } finish;
+    finish.order.reserve(g.n);
+    DfsTraversal dfs;
+    dfs.runAll(CsrAdjacency{g}, finish);
+    const vector<int32_t>& order = finish.order;
+
+    // 第二遍：反向图上按完成顺序的逆序收集
+    CsrGraph t = transposed(g);
+    vector<int32_t> comp(g.n, -1), stack;
+    for (int32_t i = g.n - 1; i >= 0; --i) {
+        int32_t s = order[i];
+        if (comp[s] != -1) continue;
+        comp[s] = s;
+        stack.assign(1, s);
+        while (!stack.empty()) {
+            int32_t u = stack.back();
+            stack.pop_back();
+            for (int64_t e = t.offsets[u]; e < t.offsets[u + 1]; ++e) {
+                int32_t w = t.targets[e];
+                if (comp[w] == -1) { comp[w] = s; stack.push_back(w); }
+            }
+        }
+    }
+    normalize(comp);
+    return comp;
+}
+
+vector<int32_t> parallelSCC(const CsrGraph& g, unsigned threads) {
+    const int kMaxColorRounds = 200;       // 着色不收敛（长链）时改用串行Tarjan
+    const int32_t kSerialCutoff = 1 << 14; // 剩余节点少于此数时直接串行
+    int32_t n = g.n;
+    CsrGraph t = transposed(g);
+    vector<int32_t> comp(n, -1);
+    Flags active = makeFlags(n, 1);
+    int64_t remaining = n;
+
+    // 1. 修剪：入度或出度（只计活跃邻居）为0的节点自成一个SCC
+    for (;;) {
+        atomic<int64_t> removed{0};
+        common::parallelChunks(n, threads, 4096, [&](int64_t b, int64_t e) {
+            int64_t local = 0;
+            for (int32_t v = (int32_t)b; v < e; ++v) {
+                if (!active[v].load(memory_order_relaxed)) continue;
+                if (!hasActiveNeighbor(g, v, active) || !hasActiveNeighbor(t, v, active)) {
+                    comp[v] = v;
+                    active[v].store(0, memory_order_relaxed);
+                    ++local;
+                }
+            }
+            removed += local;
+        });
+        remaining -= removed;
+        if (removed * 100 <= remaining) break;
+    }
+
+    // 2. 正反向可达集合的交即为枢轴所在的SCC（幂律图中通常是最大的那个）
+    if (remaining > 0) {
+        int32_t pivot = -1;
+        int64_t bestScore = -1;
+        for (int32_t v = 0; v < n; ++v) {
+            if (!active[v].load(memory_order_relaxed)) continue;
+            int64_t score = g.degree(v) * t.degree(v);
+            if (score > bestScore) { bestScore = score; pivot = v; }
+        }
+        Flags fw = makeFlags(n, 0), bw = makeFlags(n, 0);
+        vector<int32_t> reach = parallelReach(g, pivot, active, fw, threads);
+        parallelReach(t, pivot, active, bw, threads);
+        for (int32_t v : reach) {
+            if (bw[v].load(memory_order_relaxed)) {
+                comp[v] = pivot;
+                active[v].store(0, memory_order_relaxed);
+                --remaining;
+            }
+        }
+    }
+
+    // 3. 标号传播着色：颜色为能到达该节点的最大编号；颜色根沿反向边在同色节点中收集SCC
+    unique_ptr<atomic<int32_t>[]> color(new atomic<int32_t>[n]);
+    vector<int32_t> live;
+    while (remaining > kSerialCutoff) {
+        live.clear();
+        for (int32_t v = 0; v < n; ++v)
+            if (active[v].load(memory_order_relaxed)) live.push_back(v);
+        for (int32_t v : live) color[v].store(v, memory_order_relaxed);
+        bool converged = false;
+        for (int round = 0; round < kMaxColorRounds && !converged; ++round) {
+            atomic<bool> changed{false};
+            common::parallelChunks((int64_t)live.size(), threads, 1024, [&](int64_t b, int64_t e) {
+                bool local = false;
+                for (int64_t i = b; i < e; ++i) {
+                    int32_t v = live[i];
+                    int32_t cv = color[v].load(memory_order_relaxed);
+                    for (int64_t k = g.offsets[v]; k < g.offsets[v + 1]; ++k) {
+                        int32_t w = g.targets[k];
+                        if (!active[w].load(memory_order_relaxed)) continue;
+                        int32_t cw = color[w].load(memory_order_relaxed);
+                        while (cw < cv && !color[w].compare_exchange_weak(cw, cv, memory_order_relaxed)) {}
+                        local |= cw < cv;
+                    }
+                }
+                if (local) changed.store(true, memory_order_relaxed);
+            });
+            converged = !changed.load();
+        }
+        if (!converged) break;
+
+        vector<int32_t> roots;
+        for (int32_t v : live)
+            if (color[v].load(memory_order_relaxed) == v) roots.push_back(v);
+        common::parallelChunks((int64_t)roots.size(), threads, 16, [&](int64_t b, int64_t e) {
+            vector<int32_t> stack;
+            for (int64_t i = b; i < e; ++i) {
+                int32_t r = roots[i];
+                comp[r] = r;
+                stack.assign(1, r);
+                while (!stack.empty()) {
+                    int32_t u = stack.back();
+                    stack.pop_back();
+                    for (int64_t k = t.offsets[u]; k < t.offsets[u + 1]; ++k) {
+                        int32_t w = t.targets[k];
+                        // 同色节点只会被本颜色的根访问，先判颜色再读comp
+                        if (active[w].load(memory_order_relaxed) && color[w].load(memory_order_relaxed) == r &&
+                            comp[w] == -1) {
+                            comp[w] = r;
+                            stack.push_back(w);
+                        }
+                    }
+                }
+            }
+        });
+        for (int32_t v : live) {
+            if (comp[v] != -1) {
+                active[v].store(0, memory_order_relaxed);
+                --remaining;
+            }
+        }
+    }
+
+    // 4. 剩余部分串行
+    if (remaining > 0)
+        tarjanRestricted(g, [&](int32_t v) { return active[v].load(memory_order_relaxed) != 0; }, comp);
+    normalize(comp);
+    return comp;
+}
+
+int32_t countComponents(const vector<int32_t>& comp) {
+    int32_t c = 0;
+    for (int32_t v = 0; v < (int32_t)comp.size(); ++v) c += comp[v] == v;
+    return c;
+}
+
+}  // namespace ds2025::exp3
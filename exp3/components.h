@@ -0,0 +1,85 @@
+// components.h - 连通分量、强连通分量与并查集（实验3扩展）
+//
+// 所有函数返回分量编号数组comp，comp[v]为v所在分量中最小的节点编号，
+// 因此不同算法的结果可以直接比较；comp[v] == v 的节点数即分量数。
+// 邻接矩阵图先用 csrFromMatrix 转为CSR。
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "csr_graph.h"
+
+namespace ds2025::exp3 {
+
+// ========================= 无锁并查集 =========================
+// 总是把较大的根挂到较小的根下（CAS），根即集合中的最小编号；find带路径减半。
+// unite / find 可被多个线程并发调用。
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(int32_t n) : n(n), parent(new std::atomic<int32_t>[n]) {
+        for (int32_t i = 0; i < n; ++i) parent[i].store(i, std::memory_order_relaxed);
+    }
+
+    int32_t find(int32_t v) {
+        for (;;) {
+            int32_t p = parent[v].load(std::memory_order_relaxed);
+            int32_t gp = parent[p].load(std::memory_order_relaxed);
+            if (p == gp) return p;
+            parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed); // 路径减半
+            v = gp;
+        }
+    }
+
+    void unite(int32_t u, int32_t v) {
+        for (;;) {
+            u = find(u);
+            v = find(v);
+            if (u == v) return;
+            if (u < v) std::swap(u, v);
+            int32_t expected = u;
+            if (parent[u].compare_exchange_strong(expected, v, std::memory_order_relaxed)) return;
+        }
+    }
+
+    // 并发阶段结束后调用：把每个节点直接指向根
+    void compress(int32_t begin, int32_t end) {
+        for (int32_t v = begin; v < end; ++v) parent[v].store(find(v), std::memory_order_relaxed);
+    }
+
+    int32_t size() const { return n; }
+    int32_t parentOf(int32_t v) const { return parent[v].load(std::memory_order_relaxed); }
+
+private:
+    int32_t n;
+    std::unique_ptr<std::atomic<int32_t>[]> parent;
+};
+
+// ========================= 无向图连通分量 =========================
+// Afforest：先按每个节点的前两条边连接并压缩，采样找出最大分量，
+// 再只为不在最大分量中的节点处理剩余的边。g需为对称图。
+std::vector<int32_t> connectedComponents(const CsrGraph& g, unsigned threads = std::thread::hardware_concurrency());
+
+// 串行BFS标号（参考实现）
+std::vector<int32_t> connectedComponentsBFS(const CsrGraph& g);
+
+// ========================= 有向图强连通分量 =========================
+// 迭代Tarjan（显式栈，不递归）
+std::vector<int32_t> tarjanSCC(const CsrGraph& g);
+
+// 迭代Kosaraju（正向图求完成顺序，反向图按逆序收集）
+std::vector<int32_t> kosarajuSCC(const CsrGraph& g);
+
+// 并行：反复修剪入度或出度为0的节点 -> 从度数最大的节点做正反向并行BFS取出最大SCC ->
+// 剩余节点用标号传播着色（最大编号沿正向边传播），每种颜色的根沿反向边在同色节点中收集SCC
+std::vector<int32_t> parallelSCC(const CsrGraph& g, unsigned threads = std::thread::hardware_concurrency());
+
+// comp[v] == v 的个数
+int32_t countComponents(const std::vector<int32_t>& comp);
+
+}  // namespace ds2025::exp3
+
+#endif
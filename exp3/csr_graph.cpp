@@ -0,0 +1,111 @@
+// csr_graph.cpp
+#include "csr_graph.h"
+
+#include <functional>
+#include <queue>
+#include <utility>
+#include "graph.h"
+using namespace std;
+
+namespace ds2025::exp3 {
+
+CsrGraph csrFromEdges(int32_t n, const uint32_t* src, const uint32_t* dst, const int* weight, size_t m,
+                      bool symmetric) {
+    CsrGraph g;
+    g.n = n;
+    g.offsets.assign((size_t)n + 1, 0);
+    // 第一遍统计出度，第二遍按起点写入
+    for (size_t i = 0; i < m; ++i) {
+        if (src[i] == dst[i]) continue;
+        ++g.offsets[src[i] + 1];
+        if (symmetric) ++g.offsets[dst[i] + 1];
+    }
+    for (int32_t u = 0; u < n; ++u) g.offsets[u + 1] += g.offsets[u];
+    g.targets.resize(g.offsets[n]);
+    g.weights.resize(g.offsets[n]);
+    vector<int64_t> pos(g.offsets.begin(), g.offsets.end() - 1);
+    for (size_t i = 0; i < m; ++i) {
+        if (src[i] == dst[i]) continue;
+        int64_t p = pos[src[i]]++;
+        g.targets[p] = (int32_t)dst[i];
+        g.weights[p] = weight[i];
+        if (symmetric) {
+            p = pos[dst[i]]++;
+            g.targets[p] = (int32_t)src[i];
+            g.weights[p] = weight[i];
+        }
+    }
+    return g;
+}
+
+CsrGraph csrFromMatrix(const Graph& m) {
+    CsrGraph g;
+    g.n = m.n;
+    g.offsets.assign((size_t)m.n + 1, 0);
+    for (int u = 0; u < m.n; ++u) {
+        for (int v = 0; v < m.n; ++v) {
+            if (u != v && m.adjMatrix[u][v] > 0) {
+                g.targets.push_back(v);
+                g.weights.push_back(m.adjMatrix[u][v]);
+            }
+        }
+        g.offsets[u + 1] = (int64_t)g.targets.size();
+    }
+    return g;
+}
+
+CsrGraph transposed(const CsrGraph& g) {
+    CsrGraph t;
+    t.n = g.n;
+    t.offsets.assign((size_t)g.n + 1, 0);
+    for (int32_t v : g.targets) ++t.offsets[v + 1];
+    for (int32_t u = 0; u < g.n; ++u) t.offsets[u + 1] += t.offsets[u];
+    t.targets.resize(g.targets.size());
+    t.weights.resize(g.weights.size());
+    vector<int64_t> pos(t.offsets.begin(), t.offsets.end() - 1);
+    for (int32_t u = 0; u < g.n; ++u) {
+        for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            int64_t p = pos[g.targets[e]]++;
+            t.targets[p] = u;
+            t.weights[p] = g.weights[e];
+        }
+    }
+    return t;
+}
+
+vector<int64_t> bfsLevels(const CsrGraph& g, int32_t source) {
+    vector<int64_t> level(g.n, kInfDist);
+    vector<int32_t> frontier = {source}, next;
+    level[source] = 0;
+    for (int64_t depth = 1; !frontier.empty(); ++depth) {
+        next.clear();
+        for (int32_t u : frontier) {
+            for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                int32_t v = g.targets[e];
+                if (level[v] == kInfDist) { level[v] = depth; next.push_back(v); }
+            }
+        }
+        frontier.swap(next);
+    }
+    return level;
+}
+
+vector<int64_t> dijkstraDistances(const CsrGraph& g, int32_t source) {
+    vector<int64_t> dist(g.n, kInfDist);
+    priority_queue<pair<int64_t, int32_t>, vector<pair<int64_t, int32_t>>, greater<pair<int64_t, int32_t>>> pq;
+    dist[source] = 0;
+    pq.push({0, source});
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (d != dist[u]) continue; // 过期条目
+        for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            int32_t v = g.targets[e];
+            int64_t nd = d + g.weights[e];
+            if (nd < dist[v]) { dist[v] = nd; pq.push({nd, v}); }
+        }
+    }
+    return dist;
+}
+
+}  // namespace ds2025::exp3
@@ -0,0 +1,44 @@
+// csr_graph.h - 压缩稀疏行（CSR）存储的有向带权图及单机参考算法（实验3扩展）
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ds2025::exp3 {
+
+class Graph;
+
+const int64_t kInfDist = INT64_MAX; // 不可达
+
+// 节点u的出边为 targets/weights[offsets[u], offsets[u+1])
+struct CsrGraph {
+    int32_t n = 0;
+    std::vector<int64_t> offsets;   // n+1 项
+    std::vector<int32_t> targets;
+    std::vector<int32_t> weights;
+
+    int64_t edgeCount() const { return (int64_t)targets.size(); }
+    int64_t degree(int32_t u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+// 由边表构建（计数排序，丢弃自环）；symmetric为true时每条边同时加入反向边
+CsrGraph csrFromEdges(int32_t n, const uint32_t* src, const uint32_t* dst, const int* weight, size_t m,
+                      bool symmetric);
+
+// 由邻接矩阵图构建（权值>0的非对角元素为边）
+CsrGraph csrFromMatrix(const Graph& g);
+
+// 反向图（每条边u->v变为v->u，权值不变）
+CsrGraph transposed(const CsrGraph& g);
+
+// 单机BFS层数（不可达为kInfDist）
+std::vector<int64_t> bfsLevels(const CsrGraph& g, int32_t source);
+
+// 单机Dijkstra最短距离（二叉堆，不可达为kInfDist）
+std::vector<int64_t> dijkstraDistances(const CsrGraph& g, int32_t source);
+
+}  // namespace ds2025::exp3
+
+#endif
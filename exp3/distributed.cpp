@@ -0,0 +1,557 @@
+// distributed.cpp
+#include "distributed.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "csr_graph.h"
+#include "partition.h"
+using namespace std;
+
+namespace ds2025::exp3 {
+
+namespace {
+
+// ========================= 字节流传输：统一的分帧与全交换 =========================
+// 每条消息为8字节长度 + 负载；子类只需提供非阻塞的收发和等待
+class StreamTransport : public Transport {
+public:
+    StreamTransport(int rank, int size) : rank_(rank), size_(size) {}
+    int rank() const override { return rank_; }
+    int size() const override { return size_; }
+
+    void allToAll(const vector<vector<char>>& out, vector<vector<char>>& in) override {
+        int P = size_;
+        in.assign(P, vector<char>());
+        vector<uint64_t> outLen(P), inLen(P);
+        vector<size_t> sent(P, 0), got(P, 0);   // 已收发字节数（含8字节头）
+        vector<char> sendDone(P, 0), recvDone(P, 0);
+        int remaining = 0;
+        for (int p = 0; p < P; ++p) {
+            if (p == rank_) { sendDone[p] = recvDone[p] = 1; continue; }
+            outLen[p] = out[p].size();
+            remaining += 2;
+            ++messagesSent;
+            bytesSent += sizeof(uint64_t) + out[p].size();
+        }
+        while (remaining > 0) {
+            bool progress = false;
+            for (int p = 0; p < P; ++p) {
+                if (!sendDone[p]) {
+                    const char* ptr;
+                    size_t len;
+                    if (sent[p] < sizeof(uint64_t)) {
+                        ptr = (const char*)&outLen[p] + sent[p];
+                        len = sizeof(uint64_t) - sent[p];
+                    } else {
+                        ptr = out[p].data() + (sent[p] - sizeof(uint64_t));
+                        len = out[p].size() - (sent[p] - sizeof(uint64_t));
+                    }
+                    size_t k = len ? trySend(p, ptr, len) : 0;
+                    sent[p] += k;
+                    progress |= k > 0;
+                    if (sent[p] == sizeof(uint64_t) + out[p].size()) { sendDone[p] = 1; --remaining; progress = true; }
+                }
+                if (!recvDone[p]) {
+                    size_t k;
+                    if (got[p] < sizeof(uint64_t)) {
+                        k = tryRecv(p, (char*)&inLen[p] + got[p], sizeof(uint64_t) - got[p]);
+                        got[p] += k;
+                        if (got[p] == sizeof(uint64_t)) in[p].resize(inLen[p]);
+                    } else {
+                        size_t off = got[p] - sizeof(uint64_t);
+                        k = tryRecv(p, in[p].data() + off, inLen[p] - off);
+                        got[p] += k;
+                    }
+                    progress |= k > 0;
+                    if (got[p] >= sizeof(uint64_t) && got[p] == sizeof(uint64_t) + inLen[p]) {
+                        recvDone[p] = 1;
+                        --remaining;
+                        progress = true;
+                    }
+                }
+            }
+            if (!progress) waitForProgress(sendDone, recvDone);
+        }
+    }
+
+protected:
+    // 非阻塞：返回实际写入/读出的字节数（可为0）
+    virtual size_t trySend(int p, const char* data, size_t len) = 0;
+    virtual size_t tryRecv(int p, char* data, size_t len) = 0;
+    // 阻塞到某个未完成的方向可能有进展为止
+    virtual void waitForProgress(const vector<char>& sendDone, const vector<char>& recvDone) = 0;
+
+    int rank_, size_;
+};
+
+// ---------- Unix域套接字：每对进程一个socketpair ----------
+class SocketTransport : public StreamTransport {
+public:
+    SocketTransport(int rank, vector<int> fds) : StreamTransport(rank, (int)fds.size()), fds(move(fds)) {}
+    ~SocketTransport() override {
+        for (int fd : fds)
+            if (fd >= 0) close(fd);
+    }
+
+protected:
+    size_t trySend(int p, const char* data, size_t len) override {
+        ssize_t k = send(fds[p], data, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (k < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+            throw runtime_error(string("send: ") + strerror(errno));
+        }
+        return (size_t)k;
+    }
+
+    size_t tryRecv(int p, char* data, size_t len) override {
+        ssize_t k = recv(fds[p], data, len, MSG_DONTWAIT);
+        if (k == 0) throw runtime_error("peer " + to_string(p) + " closed the connection");
+        if (k < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+            throw runtime_error(string("recv: ") + strerror(errno));
+        }
+        return (size_t)k;
+    }
+
+    void waitForProgress(const vector<char>& sendDone, const vector<char>& recvDone) override {
+        vector<pollfd> pfd;
+        for (int p = 0; p < size_; ++p) {
+            short ev = (sendDone[p] ? 0 : POLLOUT) | (recvDone[p] ? 0 : POLLIN);
+            if (ev) pfd.push_back({fds[p], ev, 0});
+        }
+        while (poll(pfd.data(), pfd.size(), -1) < 0)
+            if (errno != EINTR) throw runtime_error(string("poll: ") + strerror(errno));
+    }
+
+private:
+    vector<int> fds;
+};
+
+// ---------- 共享内存：每个有序进程对一个单生产者单消费者环形缓冲区 ----------
+struct RingHeader {
+    alignas(64) atomic<uint64_t> head;  // 写入总字节数（生产者）
+    alignas(64) atomic<uint64_t> tail;  // 读出总字节数（消费者）
+};
+static_assert(atomic<uint64_t>::is_always_lock_free, "shared-memory rings need lock-free 64-bit atomics");
+
+size_t ringStride(size_t cap) { return (sizeof(RingHeader) + cap + 63) / 64 * 64; }
+
+// 每个进程一个门铃，放在所有环形缓冲区之后。改动环形缓冲区后递增对端的seq，
+// 对端有等待者时才用futex唤醒；等待方先登记再读seq，唤醒不会丢失。
+struct Doorbell {
+    alignas(64) atomic<uint32_t> seq;
+    atomic<uint32_t> sleepers;
+};
+static_assert(sizeof(atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain 32-bit integers");
+
+// 映射是进程间共享的，不能用FUTEX_PRIVATE_FLAG
+long futex(atomic<uint32_t>* word, int op, uint32_t val) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, val, nullptr, nullptr, 0);
+}
+
+class ShmTransport : public StreamTransport {
+public:
+    ShmTransport(int rank, int size, char* base, size_t cap)
+        : StreamTransport(rank, size), base(base), cap(cap),
+          bells((Doorbell*)(base + (size_t)size * size * ringStride(cap))) {}
+
+protected:
+    size_t trySend(int p, const char* data, size_t len) override {
+        RingHeader* h = ring(rank_, p);
+        uint64_t head = h->head.load(memory_order_relaxed);
+        size_t n = min(len, (size_t)(cap - (head - h->tail.load(memory_order_acquire))));
+        copyIn(bufferOf(h), head % cap, data, n);
+        h->head.store(head + n, memory_order_release);
+        if (n) wake(p);
+        return n;
+    }
+
+    size_t tryRecv(int p, char* data, size_t len) override {
+        RingHeader* h = ring(p, rank_);
+        uint64_t tail = h->tail.load(memory_order_relaxed);
+        size_t n = min(len, (size_t)(h->head.load(memory_order_acquire) - tail));
+        copyOut(data, bufferOf(h), tail % cap, n);
+        h->tail.store(tail + n, memory_order_release);
+        if (n) wake(p);
+        return n;
+    }
+
+    // 先让出CPU几次（对端通常马上就有进展），仍无进展再在自己的门铃上futex等待，
+    // 直到对端改动了与本进程相连的环形缓冲区
+    void waitForProgress(const vector<char>& sendDone, const vector<char>& recvDone) override {
+        for (int i = 0; i < kYieldsBeforeSleep; ++i) {
+            this_thread::yield();
+            if (canProgress(sendDone, recvDone)) return;
+        }
+        Doorbell& d = bells[rank_];
+        d.sleepers.fetch_add(1);
+        uint32_t seq = d.seq.load();
+        if (!canProgress(sendDone, recvDone)) futex(&d.seq, FUTEX_WAIT, seq); // seq已变或被信号打断时立即返回
+        d.sleepers.fetch_sub(1);
+    }
+
+private:
+    static const int kYieldsBeforeSleep = 8;
+
+    RingHeader* ring(int from, int to) const {
+        return (RingHeader*)(base + ((size_t)from * size_ + to) * ringStride(cap));
+    }
+    static char* bufferOf(RingHeader* h) { return (char*)(h + 1); }
+
+    // 递增进程p的门铃，p正在等待时唤醒它
+    void wake(int p) {
+        Doorbell& d = bells[p];
+        d.seq.fetch_add(1);
+        if (d.sleepers.load()) futex(&d.seq, FUTEX_WAKE, INT_MAX);
+    }
+
+    bool canProgress(const vector<char>& sendDone, const vector<char>& recvDone) const {
+        for (int p = 0; p < size_; ++p) {
+            if (!sendDone[p]) {
+                RingHeader* h = ring(rank_, p);
+                if (h->head.load(memory_order_relaxed) - h->tail.load(memory_order_acquire) < cap) return true;
+            }
+            if (!recvDone[p]) {
+                RingHeader* h = ring(p, rank_);
+                if (h->head.load(memory_order_acquire) != h->tail.load(memory_order_relaxed)) return true;
+            }
+        }
+        return false;
+    }
+
+    void copyIn(char* buf, size_t pos, const char* data, size_t n) const {
+        size_t first = min(n, cap - pos);
+        memcpy(buf + pos, data, first);
+        memcpy(buf, data + first, n - first);
+    }
+    void copyOut(char* data, const char* buf, size_t pos, size_t n) const {
+        size_t first = min(n, cap - pos);
+        memcpy(data, buf + pos, first);
+        memcpy(data + first, buf, n - first);
+    }
+
+    char* base;
+    size_t cap;
+    Doorbell* bells;  // size_个
+};
+
+// 进程间共享的匿名映射（fork前创建，子进程写、父进程读）
+class SharedRegion {
+public:
+    explicit SharedRegion(size_t bytes) : bytes(max<size_t>(bytes, 1)) {
+        ptr = mmap(nullptr, this->bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) throw runtime_error(string("mmap: ") + strerror(errno));
+    }
+    ~SharedRegion() { munmap(ptr, bytes); }
+    SharedRegion(const SharedRegion&) = delete;
+    SharedRegion& operator=(const SharedRegion&) = delete;
+
+    template <typename T> T* as() const { return (T*)ptr; }
+
+private:
+    void* ptr;
+    size_t bytes;
+};
+
+// ---------- 消息编码 ----------
+template <typename T>
+void put(vector<char>& buf, const T& v) {
+    size_t at = buf.size();
+    buf.resize(at + sizeof(T));
+    memcpy(buf.data() + at, &v, sizeof(T));
+}
+
+template <typename T>
+T get(const vector<char>& buf, size_t at) {
+    T v;
+    memcpy(&v, buf.data() + at, sizeof(T));
+    return v;
+}
+
+int64_t allReduceMin(Transport& t, int64_t mine) {
+    vector<vector<char>> out(t.size()), in;
+    for (auto& o : out) put(o, mine);
+    t.allToAll(out, in);
+    for (int p = 0; p < t.size(); ++p)
+        if (p != t.rank()) mine = min(mine, get<int64_t>(in[p], 0));
+    return mine;
+}
+
+// 每个进程的统计：轮数、消息数、字节数
+struct RankStats {
+    int64_t rounds;
+    uint64_t messages, bytes;
+};
+
+// ========================= 分布式BFS（按层同步） =========================
+// 消息：int64 发送方本层前沿大小 + 若干 int32 接收方本地下标
+int bfsWorker(Transport& t, const string& path, int32_t source, int64_t* globalDist, RankStats* stats) {
+    Shard s = readShard(path);
+    int P = t.size(), r = t.rank();
+    vector<int64_t> level(s.localCount, kInfDist);
+    vector<char> ghostSent(s.ghosts.size(), 0);
+    vector<int32_t> frontier, next;
+    if (source >= s.first && source < s.first + s.localCount) {
+        level[source - s.first] = 0;
+        frontier.push_back(source - s.first);
+    }
+    vector<vector<char>> out(P), in;
+    int64_t rounds = 0;
+    for (int64_t depth = 0; ; ++depth) {
+        for (auto& o : out) { o.clear(); put<int64_t>(o, (int64_t)frontier.size()); }
+        next.clear();
+        for (int32_t u : frontier) {
+            for (int64_t e = s.offsets[u]; e < s.offsets[u + 1]; ++e) {
+                int32_t v = s.targets[e];
+                if (v < s.localCount) {
+                    if (level[v] == kInfDist) { level[v] = depth + 1; next.push_back(v); }
+                } else {
+                    int32_t g = v - s.localCount;
+                    if (ghostSent[g]) continue; // 第一次发现即为最终层数，只需发一次
+                    ghostSent[g] = 1;
+                    int q = s.ghostOwner[g];
+                    put<int32_t>(out[q], s.ghosts[g] - s.bounds[q]);
+                }
+            }
+        }
+        t.allToAll(out, in);
+        ++rounds;
+        int64_t active = (int64_t)frontier.size();
+        for (int p = 0; p < P; ++p) {
+            if (p == r) continue;
+            active += get<int64_t>(in[p], 0);
+            for (size_t at = sizeof(int64_t); at < in[p].size(); at += sizeof(int32_t)) {
+                int32_t v = get<int32_t>(in[p], at);
+                if (level[v] == kInfDist) { level[v] = depth + 1; next.push_back(v); }
+            }
+        }
+        if (active == 0) break; // 所有进程本层前沿都为空，也就没有任何消息
+        frontier.swap(next);
+    }
+    copy(level.begin(), level.end(), globalDist + s.first);
+    stats[r] = {rounds, t.messagesSent, t.bytesSent};
+    return 0;
+}
+
+// ========================= 分布式SSSP（delta-stepping） =========================
+// 所有进程一起处理全局最小的非空桶B：每轮松弛本地桶B中节点的出边，远程更新按幽灵节点取最小后发送，
+// 直到一轮中所有进程都没有工作，再一起前进到下一个非空桶。
+// 消息：int64 发送方本轮处理的节点数 + int64 发送方本地最小非空桶 + 若干 (int32 下标, int64 距离)
+int ssspWorker(Transport& t, const string& path, int32_t source, int64_t delta, int64_t* globalDist,
+               RankStats* stats) {
+    Shard s = readShard(path);
+    int P = t.size(), r = t.rank();
+    const int64_t kNoBucket = INT64_MAX;
+    vector<int64_t> dist(s.localCount, kInfDist);
+    vector<int64_t> relaxedAt(s.localCount, -1); // 上次松弛出边时的距离，用于跳过重复条目
+    vector<int64_t> ghostBest(s.ghosts.size(), kInfDist); // 已发送给属主的最小距离
+    vector<char> ghostDirty(s.ghosts.size(), 0);
+    vector<int32_t> dirty;
+    map<int64_t, vector<int32_t>> buckets; // 惰性删除：条目的距离已变小则忽略
+
+    auto relaxLocal = [&](int32_t v, int64_t d) {
+        if (d < dist[v]) { dist[v] = d; buckets[d / delta].push_back(v); }
+    };
+    auto live = [&](int32_t v, int64_t b) { return dist[v] / delta == b && relaxedAt[v] != dist[v]; };
+    auto lowestBucket = [&]() {
+        while (!buckets.empty()) {
+            auto it = buckets.begin();
+            for (int32_t v : it->second)
+                if (live(v, it->first)) return it->first;
+            buckets.erase(it);
+        }
+        return kNoBucket;
+    };
+
+    if (source >= s.first && source < s.first + s.localCount) relaxLocal(source - s.first, 0);
+    int64_t rounds = 1;
+    int64_t B = allReduceMin(t, lowestBucket());
+    vector<vector<char>> out(P), in;
+    vector<int32_t> work;
+    while (B != kNoBucket) {
+        work.clear();
+        auto it = buckets.find(B);
+        if (it != buckets.end()) { work.swap(it->second); buckets.erase(it); }
+        int64_t active = 0;
+        for (int32_t u : work) {
+            if (!live(u, B)) continue;
+            relaxedAt[u] = dist[u];
+            ++active;
+            for (int64_t e = s.offsets[u]; e < s.offsets[u + 1]; ++e) {
+                int32_t v = s.targets[e];
+                int64_t nd = dist[u] + s.weights[e];
+                if (v < s.localCount) relaxLocal(v, nd);
+                else {
+                    int32_t g = v - s.localCount;
+                    if (nd < ghostBest[g]) {
+                        ghostBest[g] = nd;
+                        if (!ghostDirty[g]) { ghostDirty[g] = 1; dirty.push_back(g); }
+                    }
+                }
+            }
+        }
+        for (auto& o : out) { o.clear(); put<int64_t>(o, active); put<int64_t>(o, lowestBucket()); }
+        for (int32_t g : dirty) {
+            int q = s.ghostOwner[g];
+            put<int32_t>(out[q], s.ghosts[g] - s.bounds[q]);
+            put<int64_t>(out[q], ghostBest[g]);
+            ghostDirty[g] = 0;
+        }
+        dirty.clear();
+        t.allToAll(out, in);
+        ++rounds;
+        int64_t next = lowestBucket();
+        for (int p = 0; p < P; ++p) {
+            if (p == r) continue;
+            active += get<int64_t>(in[p], 0);
+            next = min(next, get<int64_t>(in[p], sizeof(int64_t)));
+            for (size_t at = 2 * sizeof(int64_t); at < in[p].size(); at += sizeof(int32_t) + sizeof(int64_t))
+                relaxLocal(get<int32_t>(in[p], at), get<int64_t>(in[p], at + sizeof(int32_t)));
+        }
+        // 本轮无人工作时没有任何消息，各进程报告的最小非空桶即为全局下一个桶
+        if (active == 0) B = next;
+    }
+    copy(dist.begin(), dist.end(), globalDist + s.first);
+    stats[r] = {rounds, t.messagesSent, t.bytesSent};
+    return 0;
+}
+
+DistributedResult runDistributed(const vector<string>& shardPaths, TransportKind kind,
+                                 const function<int(Transport&, int64_t*, RankStats*)>& worker) {
+    if (shardPaths.empty()) throw runtime_error("No shards");
+    int P = (int)shardPaths.size();
+    int64_t n = readShardHeader(shardPaths[0]).globalN;
+    SharedRegion distRegion(n * sizeof(int64_t)), statsRegion(P * sizeof(RankStats));
+    int64_t* dist = distRegion.as<int64_t>();
+    RankStats* stats = statsRegion.as<RankStats>();
+    if (!runLocalCluster(P, kind, [&](Transport& t) { return worker(t, dist, stats); }))
+        throw runtime_error("Distributed run failed");
+    DistributedResult res;
+    res.dist.assign(dist, dist + n);
+    res.rounds = stats[0].rounds;
+    for (int p = 0; p < P; ++p) {
+        res.messagesSent += stats[p].messages;
+        res.bytesSent += stats[p].bytes;
+    }
+    return res;
+}
+
+}  // namespace
+
+bool runLocalCluster(int procs, TransportKind kind, const function<int(Transport&)>& fn, size_t shmRingBytes) {
+    vector<vector<int>> fds(procs, vector<int>(procs, -1));
+    unique_ptr<SharedRegion> shm;
+    auto closeAll = [&] {
+        for (auto& row : fds)
+            for (int& fd : row)
+                if (fd >= 0) { close(fd); fd = -1; }
+    };
+    if (kind == TransportKind::UnixSocket) {
+        for (int i = 0; i < procs; ++i) {
+            for (int j = i + 1; j < procs; ++j) {
+                int sv[2];
+                if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+                    closeAll();
+                    throw runtime_error(string("socketpair: ") + strerror(errno));
+                }
+                fds[i][j] = sv[0];
+                fds[j][i] = sv[1];
+            }
+        }
+    } else {
+        size_t rings = (size_t)procs * procs * ringStride(shmRingBytes);
+        shm.reset(new SharedRegion(rings + procs * sizeof(Doorbell)));
+        for (int i = 0; i < procs * procs; ++i) new (shm->as<char>() + i * ringStride(shmRingBytes)) RingHeader{{0}, {0}};
+        for (int r = 0; r < procs; ++r) new (shm->as<char>() + rings + r * sizeof(Doorbell)) Doorbell{{0}, {0}};
+    }
+
+    // 避免子进程重复输出父进程缓冲区中的内容
+    cout.flush();
+    fflush(nullptr);
+    vector<pid_t> pids;
+    for (int r = 0; r < procs; ++r) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            for (pid_t c : pids) kill(c, SIGKILL);
+            for (pid_t c : pids) waitpid(c, nullptr, 0);
+            closeAll();
+            throw runtime_error(string("fork: ") + strerror(errno));
+        }
+        if (pid == 0) {
+            for (int i = 0; i < procs; ++i)
+                if (i != r)
+                    for (int fd : fds[i])
+                        if (fd >= 0) close(fd);
+            int code;
+            try {
+                unique_ptr<Transport> t;
+                if (kind == TransportKind::UnixSocket) t.reset(new SocketTransport(r, fds[r]));
+                else t.reset(new ShmTransport(r, procs, shm->as<char>(), shmRingBytes));
+                code = fn(*t);
+            } catch (exception& e) {
+                cerr << "rank " << r << ": " << e.what() << endl;
+                code = 1;
+            }
+            cout.flush();
+            _exit(code); // 不执行父进程注册的退出处理
+        }
+        pids.push_back(pid);
+    }
+    closeAll();
+
+    // 只回收自己的子进程；任一失败时终止其余进程（共享内存传输中对端会一直等待）
+    bool ok = true;
+    for (size_t left = pids.size(); left > 0;) {
+        bool reaped = false;
+        for (pid_t& c : pids) {
+            if (c < 0) continue;
+            int status;
+            pid_t res = waitpid(c, &status, WNOHANG);
+            if (res == 0) continue;
+            bool failed = res < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+            c = -1;
+            --left;
+            reaped = true;
+            if (failed && ok) {
+                ok = false;
+                for (pid_t other : pids)
+                    if (other > 0) kill(other, SIGKILL);
+            }
+        }
+        if (!reaped) this_thread::sleep_for(chrono::microseconds(200));
+    }
+    return ok;
+}
+
+DistributedResult distributedBFS(const vector<string>& shardPaths, int32_t source, TransportKind kind) {
+    return runDistributed(shardPaths, kind, [&](Transport& t, int64_t* dist, RankStats* stats) {
+        return bfsWorker(t, shardPaths[t.rank()], source, dist, stats);
+    });
+}
+
+DistributedResult distributedSSSP(const vector<string>& shardPaths, int32_t source, int64_t delta, TransportKind kind) {
+    if (delta <= 0) throw runtime_error("delta must be positive");
+    return runDistributed(shardPaths, kind, [&](Transport& t, int64_t* dist, RankStats* stats) {
+        return ssspWorker(t, shardPaths[t.rank()], source, delta, dist, stats);
+    });
+}
+
+}  // namespace ds2025::exp3
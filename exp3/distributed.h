@@ -0,0 +1,58 @@
+// distributed.h - 多进程分布式BFS / SSSP（delta-stepping）与可替换的本地传输层（实验3扩展）
+//
+// 每个进程只读入自己的分片文件（partition.h），按轮次同步：本地扩展前沿，
+// 发往其他分片的更新按目标进程打包、按幽灵节点聚合（BFS每个幽灵节点只发一次，
+// SSSP每轮只发最小距离且仅在优于上次发送值时发送），再通过一次全交换（allToAll）互发。
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ds2025::exp3 {
+
+// ========================= 传输层 =========================
+class Transport {
+public:
+    virtual ~Transport() {}
+    virtual int rank() const = 0;
+    virtual int size() const = 0;
+    // 全交换：out[p]发给进程p（out[rank()]被忽略），返回时in[p]为从p收到的消息。
+    // 每对进程之间消息按发送顺序到达；内部交替收发，不会因双方同时发送大消息而死锁。
+    virtual void allToAll(const std::vector<std::vector<char>>& out, std::vector<std::vector<char>>& in) = 0;
+
+    uint64_t messagesSent = 0, bytesSent = 0;
+};
+
+enum class TransportKind { UnixSocket, SharedMemory };
+
+// fork出procs个子进程，第r个以rank r的传输端点调用fn，返回值作为退出码
+// （异常视为失败）。所有子进程退出码为0时返回true。
+// shmRingBytes为共享内存传输每个方向环形缓冲区的大小。
+// 调用时进程中不能有其他线程在运行（ThreadPool、parallelChunks等创建的线程须已退出）：
+// 子进程只复制调用线程，其他线程持有的锁（malloc、iostream等）在子进程中永远不会释放。
+// fn内部可以自行创建线程。
+bool runLocalCluster(int procs, TransportKind kind, const std::function<int(Transport&)>& fn,
+                     size_t shmRingBytes = 1 << 20);
+
+// ========================= 分布式算法 =========================
+struct DistributedResult {
+    std::vector<int64_t> dist;      // 全局距离（BFS为层数），不可达为kInfDist
+    int64_t rounds = 0;             // 全交换次数（每个进程相同）
+    uint64_t messagesSent = 0, bytesSent = 0; // 所有进程合计
+};
+
+// shardPaths[k]为分片k的文件，每个分片一个进程
+DistributedResult distributedBFS(const std::vector<std::string>& shardPaths, int32_t source,
+                                 TransportKind kind = TransportKind::UnixSocket);
+
+// delta-stepping：桶宽delta（>0），边权需为正
+DistributedResult distributedSSSP(const std::vector<std::string>& shardPaths, int32_t source, int64_t delta,
+                                  TransportKind kind = TransportKind::UnixSocket);
+
+}  // namespace ds2025::exp3
+
+#endif
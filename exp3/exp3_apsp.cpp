@@ -0,0 +1,99 @@
+// exp3_apsp.cpp - 全源最短路径：分块Floyd-Warshall、多源Dijkstra与三重循环对照，结果写入可映射文件
+// 用法：exp3_apsp [n=512] [scale=11]
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../common/datagen.h"
+#include "apsp.h"
+#include "csr_graph.h"
+#include "graph.h"
+using namespace std;
+using namespace ds2025::exp3;
+
+static bool ok = true;
+
+static DistMatrix timed(const string& name, const function<DistMatrix()>& fn, const DistMatrix* ref = nullptr) {
+    auto t0 = chrono::steady_clock::now();
+    DistMatrix d = fn();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    cout << name << "：" << ms << " ms";
+    if (ref) {
+        bool same = d.rows == ref->rows && d.cols == ref->cols && d.cells == ref->cells;
+        ok &= same;
+        cout << (same ? "，结果一致" : "，结果不一致！");
+    }
+    cout << "\n";
+    return d;
+}
+
+static vector<int32_t> allSources(int32_t n) {
+    vector<int32_t> s(n);
+    for (int32_t v = 0; v < n; ++v) s[v] = v;
+    return s;
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 512;
+    int scale = argc > 2 ? atoi(argv[2]) : 11;
+
+    // 图1：输出距离表
+    Graph graph1(8, {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H'});
+    int edges1[][3] = {{0, 1, 4},  {0, 3, 6}, {0, 6, 7},  {1, 2, 12}, {1, 3, 9},  {1, 4, 1},  {2, 5, 2}, {2, 7, 10},
+                       {3, 4, 13}, {3, 6, 2}, {4, 5, 5},  {4, 6, 11}, {4, 7, 8},  {5, 7, 3},  {6, 7, 14}};
+    for (auto& e : edges1) graph1.addEdge(e[0], e[1], e[2]);
+    DistMatrix d1 = floydWarshall(graph1);
+    cout << "图1全源最短距离：\n ";
+    for (char c : graph1.nodes) cout << "\t" << c;
+    cout << "\n";
+    for (int u = 0; u < graph1.n; ++u) {
+        cout << graph1.nodes[u];
+        for (int v = 0; v < graph1.n; ++v) cout << "\t" << d1.at(u, v);
+        cout << "\n";
+    }
+    ok &= d1.cells == floydWarshallNaive(graph1).cells;
+
+    // 稠密随机有向图（约30%的边，权值1~100），节点数不是块边长的倍数以覆盖补齐
+    ds2025::datagen::CounterRng rng(2025);
+    Graph dense(n, vector<char>(n, '?'));
+    for (int u = 0; u < n; ++u)
+        for (int v = 0; v < n; ++v)
+            if (u != v && rng.uniform((uint64_t)u * n + v, 0) < 0.3)
+                dense.adjMatrix[u][v] = (int)rng.range((uint64_t)u * n + v, 1, 1, 100);
+    cout << "\n稠密随机图：" << n << " 个节点\n";
+    auto ref = timed("三重循环Floyd-Warshall", [&] { return floydWarshallNaive(dense); });
+    timed("分块Floyd-Warshall    ", [&] { return floydWarshall(dense); }, &ref);
+    CsrGraph dcsr = csrFromMatrix(dense);
+    timed("多源Dijkstra          ", [&] { return multiSourceDijkstra(dcsr, allSources(n)); }, &ref);
+
+    // 稀疏R-MAT图（平均出度8，有不可达节点对）
+    ds2025::datagen::RmatParams rp;
+    rp.scale = scale;
+    size_t m = (size_t)8 << scale;
+    vector<uint32_t> src(m), dst(m);
+    vector<int> w(m);
+    ds2025::datagen::fillRmatEdges(src.data(), dst.data(), w.data(), m, rp, 2025);
+    CsrGraph sparse = csrFromEdges(1 << scale, src.data(), dst.data(), w.data(), m, false);
+    cout << "\n稀疏R-MAT图：" << sparse.n << " 个节点，" << sparse.edgeCount() << " 条边\n";
+    auto sref = timed("分块Floyd-Warshall    ", [&] { return floydWarshall(sparse); });
+    auto sd = timed("自动选择              ", [&] { return allPairsShortestPaths(sparse); }, &sref);
+
+    // 写入文件后映射读取
+    string path = (filesystem::temp_directory_path() / ("ds2025_apsp_" + to_string(getpid()) + ".bin")).string();
+    writeDistMatrix(sd, path);
+    {
+        MappedDistMatrix mapped(path);
+        bool same = mapped.rows() == sd.rows && mapped.cols() == sd.cols &&
+                    memcmp(mapped.row(0), sd.cells.data(), sd.cells.size() * sizeof(int32_t)) == 0;
+        ok &= same;
+        cout << "映射文件 " << filesystem::file_size(path) << " 字节" << (same ? "，内容一致" : "，内容不一致！") << "\n";
+    }
+    filesystem::remove(path);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// exp3_traversal.cpp - 迭代DFS/BFS框架：千万节点长链不递归，边分类与BFS层序自检
+// 用法：exp3_traversal [chain=10000000] [scale=16]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../common/datagen.h"
+#include "csr_graph.h"
+#include "traversal.h"
+using namespace std;
+using namespace ds2025::exp3;
+
+static bool ok = true;
+
+static void check(const string& what, bool pass) {
+    ok &= pass;
+    cout << what << (pass ? "：通过" : "：失败！") << "\n";
+}
+
+// 记录发现/完成时间与各类边的数量
+struct TimeVisitor : TraversalVisitor {
+    vector<int64_t> disc, fin;
+    int64_t clock = 0, tree = 0, back = 0, other = 0;
+    explicit TimeVisitor(int32_t n) : disc(n, -1), fin(n, -1) {}
+    void discover(int32_t u) { disc[u] = clock++; }
+    void finish(int32_t u) { fin[u] = clock++; }
+    void treeEdge(int32_t, int32_t) { ++tree; }
+    void backEdge(int32_t, int32_t) { ++back; }
+    void forwardOrCrossEdge(int32_t, int32_t) { ++other; }
+};
+
+// 当前深度与最大深度
+struct DepthVisitor : TraversalVisitor {
+    int64_t depth = 0, maxDepth = 0;
+    void discover(int32_t) { maxDepth = max(maxDepth, ++depth); }
+    void finish(int32_t) { --depth; }
+};
+
+int main(int argc, char** argv) {
+    int32_t chainLen = argc > 1 ? atoi(argv[1]) : 10000000;
+    int scale = argc > 2 ? atoi(argv[2]) : 16;
+
+    // 长链 0->1->...->L-1：递归DFS需要L层调用栈
+    vector<uint32_t> cs(chainLen - 1), cd(chainLen - 1);
+    vector<int> cw(chainLen - 1, 1);
+    for (int32_t i = 0; i + 1 < chainLen; ++i) { cs[i] = i; cd[i] = i + 1; }
+    CsrGraph chain = csrFromEdges(chainLen, cs.data(), cd.data(), cw.data(), cs.size(), false);
+    DfsTraversal dfs;
+    for (int round = 1; round <= 2; ++round) {
+        auto t0 = chrono::steady_clock::now();
+        DepthVisitor depth;
+        dfs.reset(chain.n);
+        dfs.run(CsrAdjacency{chain}, 0, depth);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        cout << "长链DFS（第" << round << "次，" << chainLen << " 个节点）：最大深度 " << depth.maxDepth << "，"
+             << ms << " ms\n";
+        ok &= depth.maxDepth == chainLen && depth.depth == 0;
+    }
+
+    // R-MAT有向图：用发现/完成时间验证边分类
+    ds2025::datagen::RmatParams rp;
+    rp.scale = scale;
+    size_t m = (size_t)8 << scale;
+    vector<uint32_t> src(m), dst(m);
+    vector<int> w(m);
+    ds2025::datagen::fillRmatEdges(src.data(), dst.data(), w.data(), m, rp, 2025);
+    CsrGraph g = csrFromEdges(1 << scale, src.data(), dst.data(), w.data(), m, false);
+    cout << "\n有向R-MAT图：" << g.n << " 个节点，" << g.edgeCount() << " 条边\n";
+
+    TimeVisitor tv(g.n);
+    dfs.runAll(CsrAdjacency{g}, tv);
+    int64_t back = 0, badTree = 0;
+    for (int32_t u = 0; u < g.n; ++u) {
+        if (tv.disc[u] < 0 || tv.fin[u] < tv.disc[u]) ++badTree; // 每个节点都被发现并完成
+        for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            int32_t v = g.targets[e];
+            if (tv.disc[v] <= tv.disc[u] && tv.fin[u] <= tv.fin[v]) ++back; // v是u的祖先（或自身）
+        }
+    }
+    int64_t roots = g.n - tv.tree; // 每个非根节点恰有一条树边
+    cout << "DFS森林：" << roots << " 棵树，树边 " << tv.tree << "，回边 " << tv.back << "，前向/横跨边 " << tv.other
+         << "\n";
+    check("每条边恰好分类一次", tv.tree + tv.back + tv.other == g.edgeCount() && badTree == 0);
+    check("回边与发现/完成时间一致", back == tv.back);
+
+    // BFS：与bfsLevels对照可达集合，并检查发现顺序的层数单调
+    vector<int64_t> level = bfsLevels(g, 0);
+    struct OrderVisitor : TraversalVisitor {
+        vector<int32_t> order;
+        void discover(int32_t u) { order.push_back(u); }
+    } ov;
+    BfsTraversal bfs;
+    bfs.reset(g.n);
+    bfs.run(CsrAdjacency{g}, 0, ov);
+    bool monotone = true;
+    for (size_t i = 1; i < ov.order.size(); ++i) monotone &= level[ov.order[i - 1]] <= level[ov.order[i]];
+    int64_t reachable = 0;
+    bool sameSet = true;
+    for (int32_t v = 0; v < g.n; ++v) {
+        reachable += level[v] != kInfDist;
+        sameSet &= bfs.isVisited(v) == (level[v] != kInfDist);
+    }
+    cout << "BFS从0可达 " << ov.order.size() << " 个节点\n";
+    check("BFS可达集合与层序", sameSet && monotone && (int64_t)ov.order.size() == reachable);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+// graph.cpp
+#include "graph.h"
+
+#include <climits>
+#include <iostream>
+#include <queue>
+#include "../common/trace.h"
+#include "traversal.h"
+using namespace std;
+
+namespace ds2025::exp3 {
+
+void Graph::printAdjMatrix() {
+    cout << "邻接矩阵（-1表示无边，0表示自身，正数为权值）：" << endl;
+    // 输出表头（节点名称）
+    cout << "   ";
+    for (char c : nodes) cout << c << "  ";
+    cout << endl;
+    // 输出每行数据
+    for (int i = 0; i < n; ++i) {
+        cout << nodes[i] << "  ";
+        for (int j = 0; j < n; ++j) {
+            if (adjMatrix[i][j] == -1) cout << "-1 ";
+            else cout << adjMatrix[i][j] << "  ";
+        }
+        cout << endl;
+    }
+}
+
+// ========================= 任务2：图1的BFS和DFS =========================
+// 按发现顺序输出节点名称
+struct PrintVisitor : TraversalVisitor {
+    const Graph& g;
+    explicit PrintVisitor(const Graph& g) : g(g) {}
+    void discover(int32_t u) { cout << g.nodes[u] << " "; }
+};
+
+// BFS遍历（从startNode出发）
+void BFS(Graph& g, char startNode) {
+    int start = g.findNodeIndex(startNode);
+    if (start == -1) { cout << "起点不存在！" << endl; return; }
+
+    cout << "BFS遍历结果（从" << startNode << "出发）：";
+    BfsTraversal bfs;
+    bfs.reset(g.n);
+    PrintVisitor print(g);
+    bfs.run(MatrixAdjacency{g}, start, print);
+    cout << endl;
+}
+
+// DFS遍历（递归版，从startNode出发）
+void DFS_recursive(Graph& g, int u, vector<bool>& visited) {
+    visited[u] = true;
+    cout << g.nodes[u] << " ";
+
+    for (int v = 0; v < g.n; ++v) {
+        if (g.adjMatrix[u][v] > 0 && !visited[v]) {
+            DFS_recursive(g, v, visited);
+        }
+    }
+}
+
+// 显式栈迭代，访问顺序与DFS_recursive相同
+void DFS(Graph& g, char startNode) {
+    int start = g.findNodeIndex(startNode);
+    if (start == -1) { cout << "起点不存在！" << endl; return; }
+
+    cout << "DFS遍历结果（从" << startNode << "出发）：";
+    DfsTraversal dfs;
+    dfs.reset(g.n);
+    PrintVisitor print(g);
+    dfs.run(MatrixAdjacency{g}, start, print);
+    cout << endl;
+}
+
+// ========================= 任务3：图1的最短路径（Dijkstra）和最小支撑树（Prim） =========================
+// Dijkstra最短路径算法（从startNode出发到所有节点）
+void Dijkstra(Graph& g, char startNode) {
+    TRACE_SCOPE("Dijkstra");
+    int start = g.findNodeIndex(startNode);
+    if (start == -1) { cout << "起点不存在！" << endl; return; }
+
+    int n = g.n;
+    vector<int> dist(n, INT_MAX); // 最短距离数组
+    vector<bool> visited(n, false); // 是否确定最短路径
+    dist[start] = 0;
+
+    // 优先队列（小顶堆）：(当前距离, 节点索引)
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+    pq.push({0, start});
+    size_t pushes = 1, relaxations = 0;
+
+    while (!pq.empty()) {
+        int u = pq.top().second;
+        pq.pop();
+        if (visited[u]) continue;
+        visited[u] = true;
+
+        // 松弛操作
+        for (int v = 0; v < n; ++v) {
+            if (g.adjMatrix[u][v] > 0 && !visited[v] && dist[u] != INT_MAX) {
+                if (dist[v] > dist[u] + g.adjMatrix[u][v]) {
+                    dist[v] = dist[u] + g.adjMatrix[u][v];
+                    pq.push({dist[v], v});
+                    ++relaxations;
+                    ++pushes;
+                }
+            }
+        }
+    }
+
+    TRACE_COUNT("dijkstra.heap_pushes", pushes);
+    TRACE_COUNT("dijkstra.relaxations", relaxations);
+
+    // 输出结果
+    cout << "Dijkstra最短路径（从" << startNode << "出发）：" << endl;
+    for (int i = 0; i < n; ++i) {
+        cout << startNode << "→" << g.nodes[i] << ": ";
+        if (dist[i] == INT_MAX) cout << "不可达";
+        else cout << dist[i];
+        cout << endl;
+    }
+}
+
+// Prim最小支撑树算法（从startNode出发，无向带权图）
+void Prim(Graph& g, char startNode) {
+    TRACE_SCOPE("Prim");
+    int start = g.findNodeIndex(startNode);
+    if (start == -1) { cout << "起点不存在！" << endl; return; }
+
+    int n = g.n;
+    vector<int> key(n, INT_MAX); // 记录每个节点到生成树的最小权值
+    vector<int> parent(n, -1);   // 记录生成树中节点的父节点
+    vector<bool> inMST(n, false); // 是否已加入MST
+
+    key[start] = 0;
+    parent[start] = -1;
+    size_t keyUpdates = 0;
+
+    // 构建MST（需要n-1条边）
+    for (int i = 0; i < n - 1; ++i) {
+        // 找key最小且未加入MST的节点
+        int u = -1;
+        for (int v = 0; v < n; ++v) {
+            if (!inMST[v] && (u == -1 || key[v] < key[u])) {
+                u = v;
+            }
+        }
+
+        inMST[u] = true;
+
+        // 更新邻接节点的key值
+        for (int v = 0; v < n; ++v) {
+            if (g.adjMatrix[u][v] > 0 && !inMST[v] && g.adjMatrix[u][v] < key[v]) {
+                key[v] = g.adjMatrix[u][v];
+                parent[v] = u;
+                ++keyUpdates;
+            }
+        }
+    }
+
+    TRACE_COUNT("prim.key_updates", keyUpdates);
+
+    // 输出MST
+    cout << "Prim最小支撑树（从" << startNode << "出发）：" << endl;
+    int totalWeight = 0;
+    for (int i = 0; i < n; ++i) {
+        if (parent[i] != -1) {
+            cout << g.nodes[parent[i]] << "-" << g.nodes[i] << "（权值：" << g.adjMatrix[parent[i]][i] << "）" << endl;
+            totalWeight += g.adjMatrix[parent[i]][i];
+        }
+    }
+    cout << "MST总权值：" << totalWeight << endl;
+}
+
+// ========================= 任务4：图2的双连通分量和关节点（修复后Tarjan算法） =========================
+void BiconnectedComponent::tarjan(int u) {
+    int children = 0;
+    disc[u] = low[u] = ++time;
+
+    for (int v : adj[u]) {
+        if (disc[v] == -1) { // 未访问过
+            children++;
+            parent[v] = u;
+            edgeStack.push({u, v});
+            tarjan(v);
+
+            // 更新low[u]
+            low[u] = min(low[u], low[v]);
+
+            // 情况1：根节点且子节点数>=2（关节点）
+            if (parent[u] == -1 && children > 1) {
+                isArticulation[u] = true;
+                printBCC(); // 输出当前双连通分量
+            }
+
+            // 情况2：非根节点，low[v] >= disc[u]（关节点）
+            if (parent[u] != -1 && low[v] >= disc[u]) {
+                isArticulation[u] = true;
+                printBCC(); // 输出当前双连通分量
+            }
+        }
+        // 已访问过且不是父节点（回边，更新low[u]）
+        else if (v != parent[u] && disc[v] < disc[u]) {
+            low[u] = min(low[u], disc[v]);
+            edgeStack.push({u, v});
+        }
+    }
+}
+
+void BiconnectedComponent::printBCC() {
+    static int bccCount = 0;
+    cout << "双连通分量" << ++bccCount << "：";
+    vector<pair<int, int>> currentBCC;
+    size_t pops = 0;
+
+    // 弹出当前BCC的所有边（栈非空才操作）
+    while (!edgeStack.empty()) {
+        auto edge = edgeStack.top();
+        edgeStack.pop();
+        ++pops;
+        currentBCC.push_back(edge);
+
+        // 终止条件：当前边是触发BCC的关键边（避免多弹边）
+        if ((parent[edge.second] == edge.first && isArticulation[edge.first]) ||
+            (parent[edge.first] == edge.second && isArticulation[edge.second])) {
+            break;
+        }
+    }
+
+    TRACE_COUNT("tarjan.stack_pops", pops);
+
+    // 输出当前BCC的边（去重，避免重复输出同一无向边）
+    for (auto& e : currentBCC) {
+        cout << nodes[e.first] << "-" << nodes[e.second] << " ";
+    }
+    cout << endl;
+}
+
+void BiconnectedComponent::findBCCAndArticulation() {
+    TRACE_SCOPE("tarjan");
+    // 重置状态（避免多次调用时残留数据）
+    fill(disc.begin(), disc.end(), -1);
+    fill(low.begin(), low.end(), -1);
+    fill(parent.begin(), parent.end(), -1);
+    fill(isArticulation.begin(), isArticulation.end(), false);
+    time = 0;
+    while (!edgeStack.empty()) edgeStack.pop();
+
+    // 处理所有连通分量
+    for (int i = 0; i < n; ++i) {
+        if (disc[i] == -1) {
+            tarjan(i);
+            // 处理当前连通分量的剩余边（最后一个BCC）
+            if (!edgeStack.empty()) {
+                printBCC();
+            }
+        }
+    }
+
+    TRACE_COUNT("tarjan.visits", time); // 每个节点被访问时time加1
+
+    // 输出关节点
+    cout << "关节点：";
+    bool hasArticulation = false;
+    for (int i = 0; i < n; ++i) {
+        if (isArticulation[i]) {
+            cout << nodes[i] << " ";
+            hasArticulation = true;
+        }
+    }
+    if (!hasArticulation) cout << "无";
+    cout << endl;
+}
+
+}  // namespace ds2025::exp3
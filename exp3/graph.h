@@ -0,0 +1,114 @@
+// graph.h - 邻接矩阵图、遍历、最短路径、最小支撑树、双连通分量（实验3）
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <algorithm>
+#include <stack>
+#include <utility>
+#include <vector>
+
+namespace ds2025::exp3 {
+
+// ========================= 图的基础数据结构 =========================
+// n×n矩阵按行连续存储（便于分块和向量化），仍可用 m[u][v] 访问
+class AdjMatrix {
+public:
+    void assign(int n, int value) {
+        dim = n;
+        cells.assign((size_t)n * n, value);
+    }
+    int* operator[](int row) { return cells.data() + (size_t)row * dim; }
+    const int* operator[](int row) const { return cells.data() + (size_t)row * dim; }
+    int* data() { return cells.data(); }
+    const int* data() const { return cells.data(); }
+    int size() const { return dim; }
+
+private:
+    int dim = 0;
+    std::vector<int> cells;
+};
+
+class Graph {
+public:
+    int n;                  // 节点数
+    std::vector<char> nodes;     // 节点名称（A~H 或 A~L）
+    AdjMatrix adjMatrix;    // 邻接矩阵（-1表示无边，正数为权值）
+
+    // 构造函数：初始化节点和邻接矩阵
+    Graph(int nodeCount, const std::vector<char>& nodeNames) {
+        n = nodeCount;
+        nodes = nodeNames;
+        adjMatrix.assign(n, -1); // 初始化为无边
+        for (int i = 0; i < n; ++i) adjMatrix[i][i] = 0; // 自身到自身权值为0
+    }
+
+    // 添加无向边（u, v为节点索引，weight为权值）
+    void addEdge(int u, int v, int weight) {
+        adjMatrix[u][v] = weight;
+        adjMatrix[v][u] = weight;
+    }
+
+    // 输出邻接矩阵
+    void printAdjMatrix();
+
+    // 辅助函数：根据节点名称找索引
+    int findNodeIndex(char c) {
+        auto it = std::find(nodes.begin(), nodes.end(), c);
+        return it != nodes.end() ? it - nodes.begin() : -1;
+    }
+};
+
+// ========================= 任务2：图1的BFS和DFS =========================
+// BFS遍历（从startNode出发）
+void BFS(Graph& g, char startNode);
+
+// DFS遍历（递归版，深度受调用栈限制，长路径请用traversal.h中的DfsTraversal）
+void DFS_recursive(Graph& g, int u, std::vector<bool>& visited);
+// DFS遍历（显式栈，从startNode出发）
+void DFS(Graph& g, char startNode);
+
+// ========================= 任务3：图1的最短路径（Dijkstra）和最小支撑树（Prim） =========================
+// Dijkstra最短路径算法（从startNode出发到所有节点）
+void Dijkstra(Graph& g, char startNode);
+
+// Prim最小支撑树算法（从startNode出发，无向带权图）
+void Prim(Graph& g, char startNode);
+
+// ========================= 任务4：图2的双连通分量和关节点（修复后Tarjan算法） =========================
+class BiconnectedComponent {
+public:
+    std::vector<std::vector<int>>& adj; // 邻接表（图2的邻接表）
+    std::vector<char>& nodes;      // 节点名称
+    int n;                    // 节点数
+    std::vector<int> disc;         // 发现时间
+    std::vector<int> low;          // 能到达的最早发现节点
+    std::vector<int> parent;       // 父节点
+    std::vector<bool> isArticulation; // 是否为关节点
+    std::stack<std::pair<int, int>> edgeStack; // 存储边
+    int time;                 // 时间戳
+
+    BiconnectedComponent(std::vector<std::vector<int>>& adjList, std::vector<char>& nodeNames) 
+        : adj(adjList), nodes(nodeNames) {
+        n = adj.size();
+        disc.resize(n, -1);
+        low.resize(n, -1);
+        parent.resize(n, -1);
+        isArticulation.resize(n, false);
+        time = 0;
+        // 清空栈（防止残留）
+        while (!edgeStack.empty()) edgeStack.pop();
+    }
+
+    // Tarjan算法找双连通分量和关节点
+    void tarjan(int u);
+
+    // 修复后的双连通分量输出（避免空栈访问）
+    void printBCC();
+
+    // 执行算法并输出结果（处理非连通图）
+    void findBCCAndArticulation();
+};
+
+}  // namespace ds2025::exp3
+
+#endif
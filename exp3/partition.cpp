@@ -0,0 +1,204 @@
+// partition.cpp
+#include "partition.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+using namespace std;
+
+namespace ds2025::exp3 {
+
+vector<int32_t> partitionByEdges(const CsrGraph& g, int parts) {
+    vector<int32_t> bounds(parts + 1, g.n);
+    bounds[0] = 0;
+    int64_t total = g.edgeCount() + g.n;
+    int k = 1;
+    for (int32_t u = 0; u < g.n && k < parts; ++u) {
+        int64_t costBefore = g.offsets[u] + u; // 节点u之前的累计代价
+        while (k < parts && costBefore >= total * k / parts) bounds[k++] = u;
+    }
+    return bounds;
+}
+
+int ownerOf(const vector<int32_t>& bounds, int32_t v) {
+    return (int)(upper_bound(bounds.begin(), bounds.end(), v) - bounds.begin()) - 1;
+}
+
+int64_t cutEdges(const CsrGraph& g, const vector<int32_t>& bounds) {
+    int64_t cut = 0;
+    for (size_t p = 0; p + 1 < bounds.size(); ++p)
+        for (int32_t u = bounds[p]; u < bounds[p + 1]; ++u)
+            for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e)
+                cut += g.targets[e] < bounds[p] || g.targets[e] >= bounds[p + 1];
+    return cut;
+}
+
+static void computeGhostOwners(Shard& s) {
+    s.ghostOwner.resize(s.ghosts.size());
+    for (size_t i = 0; i < s.ghosts.size(); ++i) s.ghostOwner[i] = ownerOf(s.bounds, s.ghosts[i]);
+}
+
+Shard buildShard(const CsrGraph& g, const vector<int32_t>& bounds, int part) {
+    Shard s;
+    s.part = part;
+    s.globalN = g.n;
+    s.bounds = bounds;
+    s.first = bounds[part];
+    s.localCount = bounds[part + 1] - bounds[part];
+    int32_t last = bounds[part + 1];
+    int64_t e0 = g.offsets[s.first], e1 = g.offsets[last];
+
+    for (int64_t e = e0; e < e1; ++e)
+        if (g.targets[e] < s.first || g.targets[e] >= last) s.ghosts.push_back(g.targets[e]);
+    sort(s.ghosts.begin(), s.ghosts.end());
+    s.ghosts.erase(unique(s.ghosts.begin(), s.ghosts.end()), s.ghosts.end());
+
+    s.offsets.resize(s.localCount + 1);
+    for (int32_t i = 0; i <= s.localCount; ++i) s.offsets[i] = g.offsets[s.first + i] - e0;
+    s.targets.resize(e1 - e0);
+    s.weights.assign(g.weights.begin() + e0, g.weights.begin() + e1);
+    for (int64_t e = e0; e < e1; ++e) {
+        int32_t t = g.targets[e];
+        if (t >= s.first && t < last) s.targets[e - e0] = t - s.first;
+        else s.targets[e - e0] = s.localCount + (int32_t)(lower_bound(s.ghosts.begin(), s.ghosts.end(), t) - s.ghosts.begin());
+    }
+    computeGhostOwners(s);
+    return s;
+}
+
+// ---------- 文件格式：头部 + bounds + offsets + targets + weights + ghosts ----------
+namespace {
+
+const char kShardMagic[8] = {'D', 'S', 'S', 'H', 'A', 'R', 'D', '1'};
+
+struct ShardHeader {
+    char magic[8];
+    int32_t part, parts;
+    int64_t globalN;
+    int32_t first, localCount;
+    int64_t edges, ghostCount;
+};
+
+struct FileCloser {
+    void operator()(FILE* f) const { fclose(f); }
+};
+using File = unique_ptr<FILE, FileCloser>;
+
+template <typename T>
+void writeArray(FILE* f, const vector<T>& v, const string& path) {
+    if (fwrite(v.data(), sizeof(T), v.size(), f) != v.size()) throw runtime_error("Write failed: " + path);
+}
+
+template <typename T>
+void readArray(FILE* f, vector<T>& v, size_t n, const string& path) {
+    v.resize(n);
+    if (fread(v.data(), sizeof(T), n, f) != n) throw runtime_error("Truncated shard: " + path);
+}
+
+// 分片数上限：头部中更大的值视为损坏，避免按坏计数分配内存
+const int32_t kMaxShardParts = 1 << 16;
+
+[[noreturn]] void corrupt(const string& path, const char* what) {
+    throw runtime_error("Corrupt shard " + path + ": " + what);
+}
+
+}  // namespace
+
+void writeShard(const Shard& s, const string& path) {
+    File f(fopen(path.c_str(), "wb"));
+    if (!f) throw runtime_error("Cannot open " + path);
+    ShardHeader h;
+    memcpy(h.magic, kShardMagic, sizeof(h.magic));
+    h.part = s.part;
+    h.parts = s.parts();
+    h.globalN = s.globalN;
+    h.first = s.first;
+    h.localCount = s.localCount;
+    h.edges = (int64_t)s.targets.size();
+    h.ghostCount = (int64_t)s.ghosts.size();
+    if (fwrite(&h, sizeof(h), 1, f.get()) != 1) throw runtime_error("Write failed: " + path);
+    writeArray(f.get(), s.bounds, path);
+    writeArray(f.get(), s.offsets, path);
+    writeArray(f.get(), s.targets, path);
+    writeArray(f.get(), s.weights, path);
+    writeArray(f.get(), s.ghosts, path);
+    if (fflush(f.get()) != 0) throw runtime_error("Write failed: " + path);
+}
+
+static ShardHeader readHeader(FILE* f, Shard& s, const string& path) {
+    ShardHeader h;
+    if (fread(&h, sizeof(h), 1, f) != 1 || memcmp(h.magic, kShardMagic, sizeof(h.magic)) != 0)
+        throw runtime_error("Not a shard file: " + path);
+    // 头部的计数在用于分配之前，先与globalN和文件大小核对
+    if (h.globalN < 0 || h.globalN > INT32_MAX) corrupt(path, "node count out of range");
+    if (h.parts <= 0 || h.parts > kMaxShardParts) corrupt(path, "partition count out of range");
+    if (h.part < 0 || h.part >= h.parts) corrupt(path, "part index out of range");
+    if (h.first < 0 || h.localCount < 0 || (int64_t)h.first + h.localCount > h.globalN)
+        corrupt(path, "node range outside the graph");
+    if (h.edges < 0) corrupt(path, "negative edge count");
+    if (h.ghostCount < 0 || h.ghostCount > h.globalN) corrupt(path, "ghost count out of range");
+    error_code ec;
+    uintmax_t size = filesystem::file_size(path, ec);
+    if (ec) throw runtime_error("Cannot stat " + path);
+    uintmax_t fixed = sizeof(h) + ((uintmax_t)h.parts + 1) * sizeof(int32_t) +
+                      ((uintmax_t)h.localCount + 1) * sizeof(int64_t) + (uintmax_t)h.ghostCount * sizeof(int32_t);
+    const uintmax_t perEdge = 2 * sizeof(int32_t);  // target + weight
+    if (size < fixed || (size - fixed) % perEdge != 0 || (size - fixed) / perEdge != (uintmax_t)h.edges)
+        corrupt(path, "section sizes do not match the file size");
+
+    s.part = h.part;
+    s.globalN = h.globalN;
+    s.first = h.first;
+    s.localCount = h.localCount;
+    readArray(f, s.bounds, (size_t)h.parts + 1, path);
+    if (s.bounds.front() != 0 || s.bounds.back() != h.globalN || !is_sorted(s.bounds.begin(), s.bounds.end()) ||
+        s.bounds[h.part] != h.first || s.bounds[h.part + 1] - h.first != h.localCount)
+        corrupt(path, "partition bounds do not match the header");
+    return h;
+}
+
+Shard readShardHeader(const string& path) {
+    File f(fopen(path.c_str(), "rb"));
+    if (!f) throw runtime_error("Cannot open " + path);
+    Shard s;
+    readHeader(f.get(), s, path);
+    return s;
+}
+
+Shard readShard(const string& path) {
+    File f(fopen(path.c_str(), "rb"));
+    if (!f) throw runtime_error("Cannot open " + path);
+    Shard s;
+    ShardHeader h = readHeader(f.get(), s, path);
+    readArray(f.get(), s.offsets, (size_t)h.localCount + 1, path);
+    readArray(f.get(), s.targets, (size_t)h.edges, path);
+    readArray(f.get(), s.weights, (size_t)h.edges, path);
+    readArray(f.get(), s.ghosts, (size_t)h.ghostCount, path);
+    if (s.offsets.front() != 0 || s.offsets.back() != h.edges || !is_sorted(s.offsets.begin(), s.offsets.end()))
+        corrupt(path, "edge offsets out of order");
+    int64_t ids = (int64_t)h.localCount + h.ghostCount;
+    for (int32_t t : s.targets)
+        if (t < 0 || t >= ids) corrupt(path, "edge target out of range");
+    for (size_t i = 0; i < s.ghosts.size(); ++i)
+        if (s.ghosts[i] < 0 || s.ghosts[i] >= h.globalN || (i > 0 && s.ghosts[i] <= s.ghosts[i - 1]))
+            corrupt(path, "ghost ids out of range or not ascending");
+    computeGhostOwners(s);
+    return s;
+}
+
+vector<string> writeShards(const CsrGraph& g, int parts, const string& dir) {
+    filesystem::create_directories(dir);
+    vector<int32_t> bounds = partitionByEdges(g, parts);
+    vector<string> paths;
+    for (int p = 0; p < parts; ++p) {
+        paths.push_back((filesystem::path(dir) / ("shard_" + to_string(p) + ".bin")).string());
+        writeShard(buildShard(g, bounds, p), paths.back());
+    }
+    return paths;
+}
+
+}  // namespace ds2025::exp3
@@ -0,0 +1,54 @@
+// partition.h - 边切分（edge-cut）图划分与分片CSR文件（实验3扩展）
+//
+// 每个节点只属于一个分片（连续编号区间），分片保存其节点的全部出边。
+// 分片内的边终点重新编号：[0, localCount) 为本地节点，localCount + g 为第g个幽灵节点
+// （属于其他分片的终点，ghosts[g]为其全局编号），这样按幽灵节点聚合消息只需数组下标。
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csr_graph.h"
+
+namespace ds2025::exp3 {
+
+// 按（出度+1）的前缀和把节点切成parts个连续区间，返回parts+1个边界
+std::vector<int32_t> partitionByEdges(const CsrGraph& g, int parts);
+
+// 跨分片的边数
+int64_t cutEdges(const CsrGraph& g, const std::vector<int32_t>& bounds);
+
+// 根据边界求节点所属分片
+int ownerOf(const std::vector<int32_t>& bounds, int32_t v);
+
+struct Shard {
+    int32_t part = 0;
+    int64_t globalN = 0;
+    std::vector<int32_t> bounds;    // 所有分片的边界（parts+1项）
+    int32_t first = 0;              // 本分片第一个节点的全局编号
+    int32_t localCount = 0;
+    std::vector<int64_t> offsets;   // localCount+1 项
+    std::vector<int32_t> targets;   // 本地下标，或 localCount + 幽灵下标
+    std::vector<int32_t> weights;
+    std::vector<int32_t> ghosts;    // 幽灵节点的全局编号（升序）
+    std::vector<int32_t> ghostOwner; // 幽灵节点所属分片（读入时计算，不落盘）
+
+    int parts() const { return (int)bounds.size() - 1; }
+};
+
+Shard buildShard(const CsrGraph& g, const std::vector<int32_t>& bounds, int part);
+
+// 二进制分片文件；读写失败抛出runtime_error
+void writeShard(const Shard& s, const std::string& path);
+Shard readShard(const std::string& path);
+
+// 只读头部和bounds（不读边），用于协调进程获取节点数和划分
+Shard readShardHeader(const std::string& path);
+
+// 划分并写出 dir/shard_<k>.bin（目录不存在时创建），返回各分片路径
+std::vector<std::string> writeShards(const CsrGraph& g, int parts, const std::string& dir);
+
+}  // namespace ds2025::exp3
+
+#endif
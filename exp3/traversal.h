@@ -0,0 +1,163 @@
+// traversal.h - 迭代DFS/BFS遍历框架（实验3扩展）
+//
+// 显式栈/队列 + 访问位图，不递归。遍历状态保存在DfsTraversal/BfsTraversal对象中，
+// 跨调用复用：只在第一次遇到更大的图或更深的路径时分配，之后每次调用只清零位图。
+// 访问者是模板参数，回调在编译期内联；从TraversalVisitor派生，只定义关心的回调即可。
+// 图通过邻接适配器访问：CsrAdjacency（CSR），MatrixAdjacency（邻接矩阵，权值>0为边）。
+// 邻居按适配器给出的顺序访问，与递归版DFS的访问顺序相同。
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include <cstdint>
+#include <vector>
+#include "csr_graph.h"
+#include "graph.h"
+
+namespace ds2025::exp3 {
+
+// ========================= 节点位图 =========================
+class VertexBitmap {
+public:
+    // 清零并改为n位，容量足够时不重新分配
+    void reset(int32_t n) { words.assign(((size_t)n + 63) / 64, 0); }
+    bool test(int32_t v) const { return (words[v >> 6] >> (v & 63)) & 1; }
+    void set(int32_t v) { words[v >> 6] |= uint64_t(1) << (v & 63); }
+
+private:
+    std::vector<uint64_t> words;
+};
+
+// ========================= 邻接适配器 =========================
+// begin(u)给出u的邻居游标；next(u, cursor, v)取出下一个邻居写入v并前移游标，没有则返回false
+struct CsrAdjacency {
+    const CsrGraph& g;
+
+    int32_t vertexCount() const { return g.n; }
+    int64_t begin(int32_t u) const { return g.offsets[u]; }
+    bool next(int32_t u, int64_t& cursor, int32_t& v) const {
+        if (cursor == g.offsets[u + 1]) return false;
+        v = g.targets[cursor++];
+        return true;
+    }
+};
+
+struct MatrixAdjacency {
+    const Graph& g;
+
+    int32_t vertexCount() const { return g.n; }
+    int64_t begin(int32_t) const { return 0; }
+    bool next(int32_t u, int64_t& cursor, int32_t& v) const {
+        const int* row = g.adjMatrix[u];
+        while (cursor < g.n) {
+            int32_t c = (int32_t)cursor++;
+            if (row[c] > 0) { v = c; return true; }
+        }
+        return false;
+    }
+};
+
+// ========================= 访问者 =========================
+// 边(u, v)的分类（DFS）：treeEdge - v首次被发现；backEdge - v是仍在栈上的祖先（含自环；
+// 无向图中还包括回到父节点的那条边）；forwardOrCrossEdge - v已完成。
+// BFS只调用discover、treeEdge和finish（u的邻居全部检查完）。
+struct TraversalVisitor {
+    void discover(int32_t) {}
+    void finish(int32_t) {}
+    void treeEdge(int32_t, int32_t) {}
+    void backEdge(int32_t, int32_t) {}
+    void forwardOrCrossEdge(int32_t, int32_t) {}
+};
+
+// ========================= DFS =========================
+class DfsTraversal {
+public:
+    // 准备遍历n个节点的图：清除所有访问标记
+    void reset(int32_t n) {
+        visited.reset(n);
+        finished.reset(n);
+    }
+
+    // 从source出发深度优先遍历（source已访问则直接返回）。不清除已有标记，
+    // 因此可以依次从多个源点调用得到DFS森林。
+    template <typename Adjacency, typename Visitor>
+    void run(const Adjacency& adj, int32_t source, Visitor& visitor) {
+        if (visited.test(source)) return;
+        visited.set(source);
+        visitor.discover(source);
+        stack.push_back({source, adj.begin(source)});
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            int32_t u = top.vertex, v;
+            if (adj.next(u, top.cursor, v)) {
+                if (!visited.test(v)) {
+                    visitor.treeEdge(u, v);
+                    visited.set(v);
+                    visitor.discover(v);
+                    stack.push_back({v, adj.begin(v)}); // top此后可能失效
+                } else if (!finished.test(v)) {
+                    visitor.backEdge(u, v);
+                } else {
+                    visitor.forwardOrCrossEdge(u, v);
+                }
+            } else {
+                finished.set(u);
+                stack.pop_back();
+                visitor.finish(u);
+            }
+        }
+    }
+
+    // 清除标记后按编号顺序从每个未访问节点出发，遍历整个图
+    template <typename Adjacency, typename Visitor>
+    void runAll(const Adjacency& adj, Visitor& visitor) {
+        reset(adj.vertexCount());
+        for (int32_t s = 0; s < adj.vertexCount(); ++s) run(adj, s, visitor);
+    }
+
+    bool isVisited(int32_t v) const { return visited.test(v); }
+
+private:
+    struct Frame {
+        int32_t vertex;
+        int64_t cursor;     // 下一个待检查的邻居
+    };
+    std::vector<Frame> stack;
+    VertexBitmap visited, finished;
+};
+
+// ========================= BFS =========================
+class BfsTraversal {
+public:
+    void reset(int32_t n) { visited.reset(n); }
+
+    // 从source出发广度优先遍历，discover按入队顺序（即层序）调用；不清除已有标记
+    template <typename Adjacency, typename Visitor>
+    void run(const Adjacency& adj, int32_t source, Visitor& visitor) {
+        if (visited.test(source)) return;
+        queue.clear();
+        visited.set(source);
+        visitor.discover(source);
+        queue.push_back(source);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int32_t u = queue[head], v;
+            for (int64_t cursor = adj.begin(u); adj.next(u, cursor, v);) {
+                if (visited.test(v)) continue;
+                visitor.treeEdge(u, v);
+                visited.set(v);
+                visitor.discover(v);
+                queue.push_back(v);
+            }
+            visitor.finish(u);
+        }
+    }
+
+    bool isVisited(int32_t v) const { return visited.test(v); }
+
+private:
+    std::vector<int32_t> queue;  // 每个节点最多入队一次，用下标出队
+    VertexBitmap visited;
+};
+
+}  // namespace ds2025::exp3
+
+#endif
@@ -0,0 +1,69 @@
+// exp4_fast_nms.cpp - Fast-NMS / Cluster-NMS 与贪心NMS对照：耗时与保留结果差异
+// 用法：exp4_fast_nms [阈值=0.5]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "fast_nms.h"
+#include "nms.h"
+using namespace std;
+using namespace ds2025::exp4;
+
+static double timedMs(const function<void()>& fn) {
+    auto t0 = chrono::steady_clock::now();
+    fn();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+// 按原始索引比较两组保留框：a中有而b中没有的个数
+static int missingFrom(const vector<BoundingBox>& a, const vector<BoundingBox>& b) {
+    vector<int> ib;
+    for (auto& x : b) ib.push_back(x.index);
+    sort(ib.begin(), ib.end());
+    int missing = 0;
+    for (auto& x : a) missing += !binary_search(ib.begin(), ib.end(), x.index);
+    return missing;
+}
+
+int main(int argc, char** argv) {
+    float threshold = argc > 1 ? (float)atof(argv[1]) : 0.5f;
+    bool ok = true;
+
+    cout << left << setw(12) << "数据分布" << setw(8) << "K" << setw(12) << "贪心(ms)" << setw(12) << "Fast(ms)"
+         << setw(12) << "Cluster(ms)" << setw(10) << "贪心保留" << setw(10) << "Fast少保留" << setw(10) << "迭代轮数"
+         << "\n" << string(86, '-') << "\n";
+    for (bool clustered : {false, true}) {
+        for (int k : {1000, 2000, 5000}) {
+            vector<BoundingBox> boxes = generateBoxes(k, clustered);
+            stable_sort(boxes.begin(), boxes.end(),
+                        [](const BoundingBox& a, const BoundingBox& b) { return a.score > b.score; });
+            vector<BoundingBox> greedy, fast, cluster;
+            int iterations = 0;
+            double tg = timedMs([&] { greedy = nms(boxes, threshold); });
+            double tf = timedMs([&] { fast = fastNms(boxes, threshold, k); });
+            double tc = timedMs([&] { cluster = clusterNms(boxes, threshold, k, 1000,
+                                                           thread::hardware_concurrency(), &iterations); });
+
+            // Fast-NMS的保留集合是贪心结果的子集，Cluster-NMS收敛后与贪心完全相同
+            bool same = cluster.size() == greedy.size() && missingFrom(greedy, cluster) == 0;
+            bool subset = missingFrom(fast, greedy) == 0;
+            ok &= same && subset;
+            cout << left << setw(12) << (clustered ? "Clustered" : "Random") << setw(8) << k << setw(12) << tg
+                 << setw(12) << tf << setw(12) << tc << setw(10) << greedy.size() << setw(10)
+                 << greedy.size() - fast.size() << setw(10) << iterations
+                 << (same && subset ? "" : "  结果不符！") << "\n";
+        }
+    }
+
+    // 面积为0的框之间交集为0，IoU按0计：阈值为0时与贪心NMS一样只保留第一个框
+    vector<BoundingBox> flat = {BoundingBox(0, 0, 0, 0, 0.9f, 0), BoundingBox(5, 5, 5, 5, 0.8f, 1),
+                                BoundingBox(1, 1, 2, 2, 0.7f, 2)};
+    bool flatSame = nms(flat, 0.0f).size() == 1 && fastNms(flat, 0.0f).size() == 1 && clusterNms(flat, 0.0f).size() == 1;
+    ok &= flatSame;
+    cout << "\n面积为0的框、阈值0：" << (flatSame ? "与贪心NMS一致" : "结果不符！") << "\n";
+    return ok ? 0 : 1;
+}
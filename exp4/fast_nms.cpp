@@ -0,0 +1,167 @@
+// fast_nms.cpp
+#include "fast_nms.h"
+
+#include <algorithm>
+#include <utility>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "../common/parallel.h"
+#include "../common/trace.h"
+using namespace std;
+
+namespace ds2025::exp4 {
+
+namespace {
+
+const int kTile = 256;  // 块边长（框数，64的倍数）：一块列数据5×256×4=5KB，常驻L1
+
+// 前k个框按坐标分列存放（SoA），补齐到kTile的倍数，补齐的框坐标和面积为0
+struct BoxColumns {
+    vector<float> x1, y1, x2, y2, area;
+
+    BoxColumns(const vector<BoundingBox>& boxes, int k) {
+        size_t padded = (size_t)(k + kTile - 1) / kTile * kTile;
+        for (auto* v : {&x1, &y1, &x2, &y2, &area}) v->assign(padded, 0.0f);
+        for (int i = 0; i < k; ++i) {
+            const BoundingBox& b = boxes[i];
+            x1[i] = b.x1; y1[i] = b.y1; x2[i] = b.x2; y2[i] = b.y2;
+            area[i] = (b.x2 - b.x1) * (b.y2 - b.y1); // 与calculateIoU的运算顺序一致
+        }
+    }
+};
+
+// 框i与框[j, j+64)的比较结果，第l位为 IoU(i, j+l) >= thr。
+// 运算顺序与calculateIoU相同；交集为0时IoU直接取0（calculateIoU对不相交的框提前返回0），
+// 否则两个面积为0的框会得到0/0=NaN，阈值<=0时与贪心NMS的结果不同
+uint64_t iouWord(const BoxColumns& c, int i, int j, float thr) {
+    uint64_t word = 0;
+#if defined(__AVX__)
+    const __m256 ax1 = _mm256_set1_ps(c.x1[i]), ay1 = _mm256_set1_ps(c.y1[i]);
+    const __m256 ax2 = _mm256_set1_ps(c.x2[i]), ay2 = _mm256_set1_ps(c.y2[i]);
+    const __m256 aa = _mm256_set1_ps(c.area[i]), t = _mm256_set1_ps(thr), zero = _mm256_setzero_ps();
+    for (int l = 0; l < 64; l += 8) {
+        __m256 iw = _mm256_max_ps(_mm256_sub_ps(_mm256_min_ps(ax2, _mm256_loadu_ps(&c.x2[j + l])),
+                                                _mm256_max_ps(ax1, _mm256_loadu_ps(&c.x1[j + l]))), zero);
+        __m256 ih = _mm256_max_ps(_mm256_sub_ps(_mm256_min_ps(ay2, _mm256_loadu_ps(&c.y2[j + l])),
+                                                _mm256_max_ps(ay1, _mm256_loadu_ps(&c.y1[j + l]))), zero);
+        __m256 inter = _mm256_mul_ps(iw, ih);
+        __m256 uni = _mm256_sub_ps(_mm256_add_ps(aa, _mm256_loadu_ps(&c.area[j + l])), inter);
+        __m256 iou = _mm256_andnot_ps(_mm256_cmp_ps(inter, zero, _CMP_EQ_OQ), _mm256_div_ps(inter, uni));
+        __m256 ge = _mm256_cmp_ps(iou, t, _CMP_GE_OQ);
+        word |= (uint64_t)(uint32_t)_mm256_movemask_ps(ge) << l;
+    }
+#elif defined(__SSE2__)
+    const __m128 ax1 = _mm_set1_ps(c.x1[i]), ay1 = _mm_set1_ps(c.y1[i]);
+    const __m128 ax2 = _mm_set1_ps(c.x2[i]), ay2 = _mm_set1_ps(c.y2[i]);
+    const __m128 aa = _mm_set1_ps(c.area[i]), t = _mm_set1_ps(thr), zero = _mm_setzero_ps();
+    for (int l = 0; l < 64; l += 4) {
+        __m128 iw = _mm_max_ps(_mm_sub_ps(_mm_min_ps(ax2, _mm_loadu_ps(&c.x2[j + l])),
+                                          _mm_max_ps(ax1, _mm_loadu_ps(&c.x1[j + l]))), zero);
+        __m128 ih = _mm_max_ps(_mm_sub_ps(_mm_min_ps(ay2, _mm_loadu_ps(&c.y2[j + l])),
+                                          _mm_max_ps(ay1, _mm_loadu_ps(&c.y1[j + l]))), zero);
+        __m128 inter = _mm_mul_ps(iw, ih);
+        __m128 uni = _mm_sub_ps(_mm_add_ps(aa, _mm_loadu_ps(&c.area[j + l])), inter);
+        __m128 iou = _mm_andnot_ps(_mm_cmpeq_ps(inter, zero), _mm_div_ps(inter, uni));
+        __m128 ge = _mm_cmpge_ps(iou, t);
+        word |= (uint64_t)(uint32_t)_mm_movemask_ps(ge) << l;
+    }
+#else
+    for (int l = 0; l < 64; ++l) {
+        int b = j + l;
+        float iw = max(min(c.x2[i], c.x2[b]) - max(c.x1[i], c.x1[b]), 0.0f);
+        float ih = max(min(c.y2[i], c.y2[b]) - max(c.y1[i], c.y1[b]), 0.0f);
+        float inter = iw * ih;
+        float iou = inter == 0.0f ? 0.0f : inter / (c.area[i] + c.area[b] - inter);
+        if (iou >= thr) word |= uint64_t(1) << l;
+    }
+#endif
+    return word;
+}
+
+// 只保留列号在 (i, k) 内的位
+uint64_t columnMask(int i, int k, int j) {
+    uint64_t mask = ~uint64_t(0);
+    if (i >= j) mask = i - j >= 63 ? 0 : mask << (i - j + 1);
+    if (k < j + 64) mask &= k <= j ? 0 : (uint64_t(1) << (k - j)) - 1;
+    return mask;
+}
+
+// Cluster-NMS迭代：只让上一轮保留的框按列取或得到被抑制集合，其余框全部保留
+// （被已淘汰的框压掉的框会恢复），直到保留集合不变。第一轮（所有框都参与）即Fast-NMS。
+vector<uint64_t> keptMask(const SuppressionMatrix& m, int maxIterations, int* iterations) {
+    vector<uint64_t> valid(m.words, ~uint64_t(0)), suppressed(m.words);
+    if (m.k % 64) valid.back() = (uint64_t(1) << (m.k % 64)) - 1;
+    vector<uint64_t> keep = valid;
+    int it = 0;
+    while (it < maxIterations) {
+        ++it;
+        fill(suppressed.begin(), suppressed.end(), 0);
+        for (int i = 0; i < m.k; ++i) {
+            if (!(keep[i >> 6] >> (i & 63) & 1)) continue;
+            const uint64_t* r = m.row(i);
+            for (int w = i >> 6; w < m.words; ++w) suppressed[w] |= r[w];
+        }
+        bool changed = false;
+        for (int w = 0; w < m.words; ++w) {
+            uint64_t next = valid[w] & ~suppressed[w];
+            changed |= next != keep[w];
+            keep[w] = next;
+        }
+        if (!changed) break;
+    }
+    if (iterations) *iterations = it;
+    return keep;
+}
+
+vector<BoundingBox> keptBoxes(const vector<BoundingBox>& sorted_boxes, const vector<uint64_t>& keep, int k) {
+    vector<BoundingBox> result;
+    for (int i = 0; i < k; ++i)
+        if (keep[i >> 6] >> (i & 63) & 1) result.push_back(sorted_boxes[i]);
+    return result;
+}
+
+}  // namespace
+
+SuppressionMatrix suppressionMatrix(const vector<BoundingBox>& sorted_boxes, int k, float iou_threshold,
+                                    unsigned threads) {
+    k = max(0, min(k, (int)sorted_boxes.size()));
+    SuppressionMatrix m;
+    m.k = k;
+    m.words = (k + 63) / 64;
+    m.bits.assign((size_t)k * m.words, 0);
+    BoxColumns cols(sorted_boxes, k);
+
+    // 上三角块(ib, jb)，jb >= ib；不同块写入的字互不重叠
+    int tiles = (k + kTile - 1) / kTile;
+    vector<pair<int, int>> work;
+    for (int ib = 0; ib < tiles; ++ib)
+        for (int jb = ib; jb < tiles; ++jb) work.push_back({ib, jb});
+    common::parallelChunks((int64_t)work.size(), threads, 1, [&](int64_t b, int64_t e) {
+        for (int64_t t = b; t < e; ++t) {
+            int i0 = work[t].first * kTile, i1 = min(k, i0 + kTile);
+            int j0 = work[t].second * kTile, j1 = min(k, j0 + kTile);
+            for (int i = i0; i < i1; ++i) {
+                uint64_t* row = m.bits.data() + (size_t)i * m.words;
+                for (int j = max(j0, (i + 1) & ~63); j < j1; j += 64)
+                    row[j >> 6] = iouWord(cols, i, j, iou_threshold) & columnMask(i, k, j);
+            }
+        }
+    });
+    return m;
+}
+
+vector<BoundingBox> fastNms(const vector<BoundingBox>& sorted_boxes, float iou_threshold, int topK, unsigned threads) {
+    TRACE_SCOPE("fastNms");
+    SuppressionMatrix m = suppressionMatrix(sorted_boxes, topK, iou_threshold, threads);
+    return keptBoxes(sorted_boxes, keptMask(m, 1, nullptr), m.k);
+}
+
+vector<BoundingBox> clusterNms(const vector<BoundingBox>& sorted_boxes, float iou_threshold, int topK,
+                               int maxIterations, unsigned threads, int* iterations) {
+    TRACE_SCOPE("clusterNms");
+    SuppressionMatrix m = suppressionMatrix(sorted_boxes, topK, iou_threshold, threads);
+    return keptBoxes(sorted_boxes, keptMask(m, maxIterations, iterations), m.k);
+}
+
+}  // namespace ds2025::exp4
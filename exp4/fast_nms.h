@@ -0,0 +1,45 @@
+// fast_nms.h - 矩阵形式的Fast-NMS / Cluster-NMS（实验4扩展）
+//
+// 对置信度最高的topK个框，按缓存大小的块并行计算上三角IoU矩阵（SIMD），
+// 每个IoU立即与阈值比较，只保存“框i抑制框j”的位矩阵（K=5000时约3MB，而不是100MB的浮点矩阵）。
+// Fast-NMS：按列取或（即列最大IoU是否达到阈值），一遍得出结果，会比贪心NMS多抑制一些框
+//          （被已抑制的框压掉的框）。
+// Cluster-NMS：只让当前保留的框参与按列取或，迭代到保留集合不变；收敛后与贪心NMS结果相同。
+// 坐标有限时IoU与calculateIoU逐位一致（交集为0时取0，包括两个面积为0的框），
+// 输入需按置信度降序排列（与nms()相同）。
+#ifndef FAST_NMS_H
+#define FAST_NMS_H
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "nms.h"
+
+namespace ds2025::exp4 {
+
+// 抑制位矩阵：第i行第j位（j > i）表示 IoU(box_i, box_j) >= 阈值
+struct SuppressionMatrix {
+    int k = 0;
+    int words = 0;                  // 每行的64位字数
+    std::vector<uint64_t> bits;     // k * words
+
+    const uint64_t* row(int i) const { return bits.data() + (size_t)i * words; }
+};
+
+// 计算sorted_boxes前k个框的抑制位矩阵，按块并行
+SuppressionMatrix suppressionMatrix(const std::vector<BoundingBox>& sorted_boxes, int k, float iou_threshold,
+                                    unsigned threads = std::thread::hardware_concurrency());
+
+// Fast-NMS：只考虑前topK个框，一遍按列抑制
+std::vector<BoundingBox> fastNms(const std::vector<BoundingBox>& sorted_boxes, float iou_threshold = 0.5f,
+                                 int topK = 5000, unsigned threads = std::thread::hardware_concurrency());
+
+// Cluster-NMS：在Fast-NMS基础上迭代，最多maxIterations轮；iterations非空时写回实际轮数
+std::vector<BoundingBox> clusterNms(const std::vector<BoundingBox>& sorted_boxes, float iou_threshold = 0.5f,
+                                    int topK = 5000, int maxIterations = 1000,
+                                    unsigned threads = std::thread::hardware_concurrency(),
+                                    int* iterations = nullptr);
+
+}  // namespace ds2025::exp4
+
+#endif
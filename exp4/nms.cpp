@@ -0,0 +1,160 @@
+// nms.cpp
+#include "nms.h"
+
+#include <algorithm>
+#include "../common/datagen.h"
+#include "../common/trace.h"
+using namespace std;
+
+namespace ds2025::exp4 {
+
+// 1. 排序算法实现（四种）
+// 1.1 快速排序（按置信度降序）
+int partition(vector<BoundingBox>& arr, int low, int high) {
+    float pivot = arr[high].score;
+    int i = low - 1;
+    for (int j = low; j < high; j++) {
+        if (arr[j].score >= pivot) { // 降序排列
+            i++;
+            swap(arr[i], arr[j]);
+        }
+    }
+    swap(arr[i + 1], arr[high]);
+    return i + 1;
+}
+
+void quickSort(vector<BoundingBox>& arr, int low, int high) {
+    if (low < high) {
+        int pi = partition(arr, low, high);
+        quickSort(arr, low, pi - 1);
+        quickSort(arr, pi + 1, high);
+    }
+}
+
+// 1.2 归并排序（按置信度降序）
+void merge(vector<BoundingBox>& arr, int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+    vector<BoundingBox> L(n1), R(n2);
+
+    for (int i = 0; i < n1; i++) L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++) R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+    while (i < n1 && j < n2) {
+        if (L[i].score >= R[j].score) arr[k++] = L[i++];
+        else arr[k++] = R[j++];
+    }
+    while (i < n1) arr[k++] = L[i++];
+    while (j < n2) arr[k++] = R[j++];
+}
+
+void mergeSort(vector<BoundingBox>& arr, int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+        merge(arr, left, mid, right);
+    }
+}
+
+// 1.3 堆排序（按置信度降序）：小顶堆，每次把最小的堆顶换到末尾
+void heapify(vector<BoundingBox>& arr, int n, int i) {
+    int smallest = i;
+    int l = 2 * i + 1;
+    int r = 2 * i + 2;
+
+    if (l < n && arr[l].score < arr[smallest].score) smallest = l;
+    if (r < n && arr[r].score < arr[smallest].score) smallest = r;
+
+    if (smallest != i) {
+        swap(arr[i], arr[smallest]);
+        heapify(arr, n, smallest);
+    }
+}
+
+void heapSort(vector<BoundingBox>& arr) {
+    int n = arr.size();
+    // 构建小顶堆
+    for (int i = n / 2 - 1; i >= 0; i--) heapify(arr, n, i);
+    // 堆排序（逐个提取堆顶元素）
+    for (int i = n - 1; i > 0; i--) {
+        swap(arr[0], arr[i]);
+        heapify(arr, i, 0);
+    }
+}
+
+// 1.4 冒泡排序（按置信度降序）
+void bubbleSort(vector<BoundingBox>& arr) {
+    int n = arr.size();
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = 0; j < n - i - 1; j++) {
+            if (arr[j].score < arr[j + 1].score) {
+                swap(arr[j], arr[j + 1]);
+            }
+        }
+    }
+}
+
+// 2. 数据生成模块（两种分布）
+// 使用计数器型随机数（datagen.h）：同一种子结果固定，多线程填充与单线程完全一致
+vector<BoundingBox> generateBoxes(int count, bool clustered, uint64_t seed) {
+    vector<BoundingBox> boxes(count); // 预分配，直接按下标写入
+    datagen::CounterRng rng(seed);
+    datagen::parallelFill(boxes.size(), datagen::defaultThreads(), [&](size_t i) {
+        datagen::Box b = datagen::boxAt(rng, i, clustered);
+        boxes[i] = BoundingBox(b.x1, b.y1, b.x2, b.y2, b.score, (int)i);
+    });
+    return boxes;
+}
+
+// 2.1 随机分布：左上角在800x600图像内均匀分布，宽高20~120，置信度0~1
+vector<BoundingBox> generateRandomBoxes(int count) {
+    return generateBoxes(count, false);
+}
+
+// 2.2 聚集分布：80%的框集中在图像中心200x200区域，20%随机分布
+vector<BoundingBox> generateClusteredBoxes(int count) {
+    return generateBoxes(count, true);
+}
+
+// 3. 基础NMS算法（依赖排序后的边界框）
+// 计算两个边界框的交并比（IoU）
+float calculateIoU(const BoundingBox& a, const BoundingBox& b) {
+    float inter_x1 = max(a.x1, b.x1);
+    float inter_y1 = max(a.y1, b.y1);
+    float inter_x2 = min(a.x2, b.x2);
+    float inter_y2 = min(a.y2, b.y2);
+
+    if (inter_x1 >= inter_x2 || inter_y1 >= inter_y2) return 0.0f;
+
+    float inter_area = (inter_x2 - inter_x1) * (inter_y2 - inter_y1);
+    float a_area = (a.x2 - a.x1) * (a.y2 - a.y1);
+    float b_area = (b.x2 - b.x1) * (b.y2 - b.y1);
+    return inter_area / (a_area + b_area - inter_area);
+}
+
+// NMS核心逻辑：输入排序后的边界框，输出去重后的结果
+vector<BoundingBox> nms(vector<BoundingBox> sorted_boxes, float iou_threshold) {
+    TRACE_SCOPE("nms");
+    size_t iouCalls = 0;
+    vector<BoundingBox> result;
+    while (!sorted_boxes.empty()) {
+        // 取置信度最高的框
+        BoundingBox top = sorted_boxes[0];
+        result.push_back(top);
+        // 移除与top框IoU超过阈值的框
+        vector<BoundingBox> temp;
+        iouCalls += sorted_boxes.size() - 1;
+        for (size_t i = 1; i < sorted_boxes.size(); i++) {
+            if (calculateIoU(top, sorted_boxes[i]) < iou_threshold) {
+                temp.push_back(sorted_boxes[i]);
+            }
+        }
+        sorted_boxes = temp;
+    }
+    TRACE_COUNT("nms.iou_calls", iouCalls);
+    return result;
+}
+
+}  // namespace ds2025::exp4
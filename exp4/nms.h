@@ -0,0 +1,53 @@
+// nms.h - 边界框、四种排序算法、数据生成、基础NMS（实验4）
+#ifndef NMS_H
+#define NMS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ds2025::exp4 {
+
+// 边界框结构体：包含位置、大小、置信度、索引（用于NMS后映射原始数据）
+struct BoundingBox {
+    float x1;     // 左上角x
+    float y1;     // 左上角y
+    float x2;     // 右下角x
+    float y2;     // 右下角y
+    float score;  // 置信度
+    int index;    // 原始索引（避免排序后丢失位置）
+
+    BoundingBox(float x1_ = 0, float y1_ = 0, float x2_ = 0, float y2_ = 0, float s_ = 0, int idx_ = 0)
+        : x1(x1_), y1(y1_), x2(x2_), y2(y2_), score(s_), index(idx_) {}
+};
+
+// 1. 排序算法实现（四种，均按置信度降序）
+int partition(std::vector<BoundingBox>& arr, int low, int high);
+void quickSort(std::vector<BoundingBox>& arr, int low, int high);
+void merge(std::vector<BoundingBox>& arr, int left, int mid, int right);
+void mergeSort(std::vector<BoundingBox>& arr, int left, int right);
+void heapify(std::vector<BoundingBox>& arr, int n, int i);
+void heapSort(std::vector<BoundingBox>& arr);
+void bubbleSort(std::vector<BoundingBox>& arr);
+
+// 2. 数据生成模块（两种分布）
+// 使用计数器型随机数（datagen.h）：同一种子结果固定，多线程填充与单线程完全一致
+const uint64_t kDataSeed = 2025;
+
+std::vector<BoundingBox> generateBoxes(int count, bool clustered, uint64_t seed = kDataSeed);
+
+// 2.1 随机分布：左上角在800x600图像内均匀分布，宽高20~120，置信度0~1
+std::vector<BoundingBox> generateRandomBoxes(int count);
+
+// 2.2 聚集分布：80%的框集中在图像中心200x200区域，20%随机分布
+std::vector<BoundingBox> generateClusteredBoxes(int count);
+
+// 3. 基础NMS算法（依赖排序后的边界框）
+// 计算两个边界框的交并比（IoU）
+float calculateIoU(const BoundingBox& a, const BoundingBox& b);
+
+// NMS核心逻辑：输入排序后的边界框，输出去重后的结果
+std::vector<BoundingBox> nms(std::vector<BoundingBox> sorted_boxes, float iou_threshold = 0.5f);
+
+}  // namespace ds2025::exp4
+
+#endif
@@ -0,0 +1,289 @@
+// ds2025_tests.cpp - assertion-based checks against known outputs and brute-force references
+//
+// The experiment programs registered with CTest are smoke runs; this executable is the one
+// that checks results. Every failed CHECK prints its location and the run exits non-zero.
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+
+#include "csr_graph.h"
+#include "fast_nms.h"
+#include "graph.h"
+#include "huffman_tree.h"
+#include "nms.h"
+#include "partition.h"
+
+using namespace ds2025;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond)                                                                       \
+    do {                                                                                  \
+        if (!(cond)) {                                                                    \
+            ++failures;                                                                   \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                                 \
+    } while (0)
+
+// Runs fn with std::cout redirected and returns what it printed
+std::string captureCout(const std::function<void()>& fn) {
+    std::ostringstream out;
+    std::streambuf* old = std::cout.rdbuf(out.rdbuf());
+    fn();
+    std::cout.rdbuf(old);
+    return out.str();
+}
+
+// ========================= exp2: Huffman coding =========================
+std::string huffmanDecode(const exp2::HuffNode* root, const std::string& bits) {
+    std::string out;
+    const exp2::HuffNode* cur = root;
+    for (char b : bits) {
+        cur = b == '0' ? cur->lc : cur->rc;
+        if (!cur) return out + "<bad path>";
+        if (!cur->lc && !cur->rc) { out += cur->ch; cur = root; }
+    }
+    return cur == root ? out : out + "<partial code>";
+}
+
+void checkHuffman(const std::string& text) {
+    std::unordered_map<char, int> freq;
+    for (char c : text) ++freq[c];
+    exp2::HuffNode* root = exp2::buildHuffmanTree(freq);
+    std::unordered_map<char, std::string> code;
+    exp2::generateCodes(root, "", code);
+
+    CHECK(code.size() == freq.size());
+    for (auto& a : code) {
+        CHECK(!a.second.empty());
+        for (auto& b : code)
+            if (a.first != b.first) CHECK(b.second.compare(0, a.second.size(), a.second) != 0);  // prefix-free
+    }
+
+    // optimal: the weighted code length equals the sum of all merged weights
+    std::priority_queue<long long, std::vector<long long>, std::greater<long long>> heap;
+    for (auto& p : freq) heap.push(p.second);
+    long long optimal = 0;
+    while (heap.size() > 1) {
+        long long a = heap.top(); heap.pop();
+        long long b = heap.top(); heap.pop();
+        optimal += a + b;
+        heap.push(a + b);
+    }
+    long long weighted = 0;
+    for (auto& p : freq) weighted += (long long)p.second * code[p.first].size();
+    CHECK(weighted == optimal);
+
+    std::string bits;
+    for (char c : text) bits += code[c];
+    CHECK(huffmanDecode(root, bits) == text);
+    exp2::freeHuffmanTree(root);
+}
+
+void testHuffman() {
+    CHECK(exp2::buildHuffmanTree({}) == nullptr);
+    checkHuffman("ab");
+    checkHuffman("abracadabra");
+    checkHuffman("the quick brown fox jumps over the lazy dog, again and again");
+    std::string skewed;
+    for (int i = 0; i < 20; ++i) skewed += std::string(1u << (i % 12), char('a' + i));
+    checkHuffman(skewed);
+}
+
+// ========================= exp3: graph 1 of the assignment =========================
+exp3::Graph graph1() {
+    exp3::Graph g(8, {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H'});
+    g.addEdge(0, 1, 4);  g.addEdge(0, 3, 6);  g.addEdge(0, 6, 7);  g.addEdge(1, 2, 12);
+    g.addEdge(1, 3, 9);  g.addEdge(1, 4, 1);  g.addEdge(2, 5, 2);  g.addEdge(2, 7, 10);
+    g.addEdge(3, 4, 13); g.addEdge(3, 6, 2);  g.addEdge(4, 5, 5);  g.addEdge(4, 6, 11);
+    g.addEdge(4, 7, 8);  g.addEdge(5, 7, 3);  g.addEdge(6, 7, 14);
+    return g;
+}
+
+void testGraph() {
+    exp3::Graph g = graph1();
+    CHECK(captureCout([&] { exp3::BFS(g, 'A'); }) == "BFS遍历结果（从A出发）：A B D G C E H F \n");
+    CHECK(captureCout([&] { exp3::DFS(g, 'A'); }) == "DFS遍历结果（从A出发）：A B C F E D G H \n");
+
+    std::vector<bool> visited(g.n, false);
+    CHECK(captureCout([&] { exp3::DFS_recursive(g, 0, visited); }) == "A B C F E D G H ");
+
+    CHECK(captureCout([&] { exp3::Dijkstra(g, 'A'); }) ==
+          "Dijkstra最短路径（从A出发）：\n"
+          "A→A: 0\nA→B: 4\nA→C: 12\nA→D: 6\nA→E: 5\nA→F: 10\nA→G: 7\nA→H: 13\n");
+
+    CHECK(captureCout([&] { exp3::Prim(g, 'A'); }) ==
+          "Prim最小支撑树（从A出发）：\n"
+          "A-B（权值：4）\nF-C（权值：2）\nA-D（权值：6）\nB-E（权值：1）\n"
+          "E-F（权值：5）\nD-G（权值：2）\nF-H（权值：3）\nMST总权值：23\n");
+
+    // unreachable vertex and unknown start
+    exp3::Graph split(3, {'X', 'Y', 'Z'});
+    split.addEdge(0, 1, 3);
+    CHECK(captureCout([&] { exp3::Dijkstra(split, 'X'); }) ==
+          "Dijkstra最短路径（从X出发）：\nX→X: 0\nX→Y: 3\nX→Z: 不可达\n");
+    CHECK(captureCout([&] { exp3::BFS(split, 'Q'); }) == "起点不存在！\n");
+}
+
+// ========================= exp3: shard files =========================
+std::string readBytes(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+void writeBytes(const std::string& path, const std::string& bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+}
+
+template <typename T>
+std::string patched(std::string bytes, size_t offset, T value) {
+    std::memcpy(&bytes[offset], &value, sizeof value);
+    return bytes;
+}
+
+// a damaged shard must be rejected with an error naming the file, before anything is sized from it
+bool rejects(const std::string& path, const std::string& bytes) {
+    writeBytes(path, bytes);
+    try {
+        exp3::readShard(path);
+    } catch (const std::runtime_error& e) {
+        return std::string(e.what()).find(path) != std::string::npos;
+    }
+    return false;
+}
+
+void testShards() {
+    exp3::Graph g = graph1();
+    exp3::CsrGraph csr = exp3::csrFromMatrix(g);
+    std::string dir = (std::filesystem::temp_directory_path() / ("ds2025_tests_" + std::to_string(getpid()))).string();
+    std::vector<std::string> paths = exp3::writeShards(csr, 3, dir);
+    std::vector<int32_t> bounds = exp3::partitionByEdges(csr, 3);
+    for (int p = 0; p < 3; ++p) {
+        exp3::Shard expect = exp3::buildShard(csr, bounds, p), got = exp3::readShard(paths[p]);
+        CHECK(got.bounds == expect.bounds && got.offsets == expect.offsets && got.targets == expect.targets &&
+              got.weights == expect.weights && got.ghosts == expect.ghosts && got.ghostOwner == expect.ghostOwner);
+    }
+
+    // header layout: magic[8], part, parts (int32), globalN (int64), first, localCount (int32), edges, ghostCount (int64)
+    std::string good = readBytes(paths[1]), path = dir + "/damaged.bin";
+    int32_t localCount;
+    std::memcpy(&localCount, &good[28], sizeof localCount);
+    size_t targetsAt = 48 + 4 * sizeof(int32_t) + (localCount + 1) * sizeof(int64_t);
+    CHECK(!rejects(path, good));
+    CHECK(rejects(path, patched<int32_t>(good, 12, 0)));                 // parts
+    CHECK(rejects(path, patched<int32_t>(good, 12, 1 << 30)));
+    CHECK(rejects(path, patched<int32_t>(good, 8, 3)));                  // part
+    CHECK(rejects(path, patched<int64_t>(good, 16, -1)));                // globalN
+    CHECK(rejects(path, patched<int32_t>(good, 28, -1)));                // localCount
+    CHECK(rejects(path, patched<int32_t>(good, 28, 1 << 30)));
+    CHECK(rejects(path, patched<int32_t>(good, 24, 7)));                 // first + localCount > globalN
+    CHECK(rejects(path, patched<int64_t>(good, 32, -1)));                // edges
+    CHECK(rejects(path, patched<int64_t>(good, 32, int64_t(1) << 60)));
+    CHECK(rejects(path, patched<int64_t>(good, 40, 9)));                 // ghostCount > globalN
+    CHECK(rejects(path, good.substr(0, good.size() - 1)));               // truncated
+    CHECK(rejects(path, good + std::string(8, '\0')));                   // trailing bytes
+    CHECK(rejects(path, patched<int32_t>(good, targetsAt, 1000)));       // edge target
+    CHECK(rejects(path, patched<int32_t>(good, 48, 1)));                 // bounds[0]
+    std::filesystem::remove_all(dir);
+}
+
+// ========================= exp4: NMS against brute force =========================
+double referenceIoU(const exp4::BoundingBox& a, const exp4::BoundingBox& b) {
+    double w = std::min<double>(a.x2, b.x2) - std::max<double>(a.x1, b.x1);
+    double h = std::min<double>(a.y2, b.y2) - std::max<double>(a.y1, b.y1);
+    if (w <= 0 || h <= 0) return 0;
+    double inter = w * h;
+    return inter / ((double)(a.x2 - a.x1) * (a.y2 - a.y1) + (double)(b.x2 - b.x1) * (b.y2 - b.y1) - inter);
+}
+
+// greedy NMS by definition: keep a box unless a kept, higher-ranked box overlaps it enough
+std::vector<int> referenceNms(const std::vector<exp4::BoundingBox>& sorted, double threshold) {
+    std::vector<int> kept;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        bool keep = true;
+        for (size_t j = 0; j < i && keep; ++j)
+            if (std::find(kept.begin(), kept.end(), sorted[j].index) != kept.end() &&
+                referenceIoU(sorted[j], sorted[i]) >= threshold)
+                keep = false;
+        if (keep) kept.push_back(sorted[i].index);
+    }
+    return kept;
+}
+
+// Fast-NMS by definition: drop a box if any higher-ranked box overlaps it enough
+std::vector<int> referenceFastNms(const std::vector<exp4::BoundingBox>& sorted, double threshold) {
+    std::vector<int> kept;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        bool keep = true;
+        for (size_t j = 0; j < i && keep; ++j) keep = referenceIoU(sorted[j], sorted[i]) < threshold;
+        if (keep) kept.push_back(sorted[i].index);
+    }
+    return kept;
+}
+
+std::vector<int> indices(const std::vector<exp4::BoundingBox>& boxes) {
+    std::vector<int> idx;
+    for (auto& b : boxes) idx.push_back(b.index);
+    return idx;
+}
+
+void testNms() {
+    for (int clustered = 0; clustered < 2; ++clustered) {
+        std::vector<exp4::BoundingBox> boxes = exp4::generateBoxes(600, clustered, 7 + clustered);
+        std::sort(boxes.begin(), boxes.end(), [](const exp4::BoundingBox& a, const exp4::BoundingBox& b) {
+            return a.score != b.score ? a.score > b.score : a.index < b.index;
+        });
+        for (float threshold : {0.3f, 0.5f, 0.7f}) {
+            std::vector<int> greedy = referenceNms(boxes, threshold);
+            CHECK(indices(exp4::nms(boxes, threshold)) == greedy);
+            CHECK(indices(exp4::clusterNms(boxes, threshold, (int)boxes.size(), 1000, 2)) == greedy);
+            CHECK(indices(exp4::fastNms(boxes, threshold, (int)boxes.size(), 2)) == referenceFastNms(boxes, threshold));
+        }
+    }
+
+    // the sorts order by descending score and keep every box
+    std::vector<exp4::BoundingBox> boxes = exp4::generateBoxes(300, false, 11);
+    auto bySorted = [&](const std::function<void(std::vector<exp4::BoundingBox>&)>& sortFn) {
+        std::vector<exp4::BoundingBox> v = boxes;
+        sortFn(v);
+        bool ordered = std::is_sorted(v.begin(), v.end(), [](const exp4::BoundingBox& a, const exp4::BoundingBox& b) {
+            return a.score > b.score;
+        });
+        std::vector<int> idx = indices(v);
+        std::sort(idx.begin(), idx.end());
+        std::vector<int> all(boxes.size());
+        for (size_t i = 0; i < all.size(); ++i) all[i] = boxes[i].index;
+        std::sort(all.begin(), all.end());
+        return ordered && idx == all;
+    };
+    CHECK(bySorted([](std::vector<exp4::BoundingBox>& v) { exp4::quickSort(v, 0, (int)v.size() - 1); }));
+    CHECK(bySorted([](std::vector<exp4::BoundingBox>& v) { exp4::mergeSort(v, 0, (int)v.size() - 1); }));
+    CHECK(bySorted([](std::vector<exp4::BoundingBox>& v) { exp4::heapSort(v); }));
+    CHECK(bySorted([](std::vector<exp4::BoundingBox>& v) { exp4::bubbleSort(v); }));
+}
+
+}  // namespace
+
+int main() {
+    testHuffman();
+    testGraph();
+    testShards();
+    testNms();
+    if (failures) std::cerr << failures << " check(s) failed\n";
+    else std::cout << "all checks passed\n";
+    return failures ? 1 : 0;
+}